@@ -0,0 +1,277 @@
+/**
+ * @file hamming_bench.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Host throughput benchmark for every Hamming(7,4) engine.
+ *
+ * Measures encode, decode of a clean buffer and decode of a buffer with a
+ * single-bit error in every 8th codeword, for buffer sizes from 16 B to
+ * 64 MiB. The scalar engine, built on parity_check(), is the baseline. The
+ * results are written to stdout as JSON.
+ *
+ * Before anything is timed, every engine's output is compared with the table
+ * engine's and the benchmark exits with 1 if one of them differs.
+ *
+ * Usage: hamming_bench [--engine NAME] [--max-size BYTES] [--min-time SECONDS]
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hamming.h"
+
+/** Smallest and largest buffer sizes, every step is BENCH_SIZE_STEP times larger. */
+#define BENCH_MIN_SIZE ((size_t)16)
+#define BENCH_MAX_SIZE ((size_t)64 * 1024 * 1024)
+#define BENCH_SIZE_STEP 4
+
+/** Every BENCH_ERROR_STRIDE-th codeword gets a single-bit error. */
+#define BENCH_ERROR_STRIDE 8
+
+/** Short buffer also checked, so the scalar tails of the vector engines are covered. */
+#define BENCH_CHECK_SIZE ((size_t)37)
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+typedef enum {
+    OP_ENCODE,
+    OP_DECODE_CLEAN,
+    OP_DECODE_ERRORS,
+    OP_COUNT
+} bench_op_t;
+
+static const char *const op_names[OP_COUNT] = {"encode", "decode_clean", "decode_errors"};
+
+/*-----------------------------------------------------------*/
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The buffer size after size, cut to max_size so the largest one is always timed.
+ */
+static size_t next_size(size_t size, size_t max_size)
+{
+    size_t next = size * BENCH_SIZE_STEP;
+    return (size < max_size && next > max_size) ? max_size : next;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run one operation once over size data bytes.
+ */
+static void run_op(bench_op_t op, const uint8_t *data, size_t size, uint8_t *codewords,
+                   const uint8_t *noisy, uint8_t *out)
+{
+    switch (op) {
+    case OP_ENCODE:
+        hamming74_encode_bytes(data, size, codewords);
+        break;
+    case OP_DECODE_CLEAN:
+        hamming74_decode_bytes(codewords, size, out);
+        break;
+    case OP_DECODE_ERRORS:
+        hamming74_decode_bytes(noisy, size, out);
+        break;
+    default:
+        break;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Time an operation, repeating it until min_time has passed.
+ *
+ * @return Seconds per run.
+ */
+static double time_op(bench_op_t op, const uint8_t *data, size_t size, uint8_t *codewords,
+                      const uint8_t *noisy, uint8_t *out, double min_time, size_t *iterations)
+{
+    // Warm up caches and resolve the engine outside the timed loop
+    run_op(op, data, size, codewords, noisy, out);
+
+    size_t runs = 1;
+    for (;;) {
+        double start = now_seconds();
+        for (size_t i = 0; i < runs; i++) {
+            run_op(op, data, size, codewords, noisy, out);
+        }
+        double elapsed = now_seconds() - start;
+
+        if (elapsed >= min_time || runs >= ((size_t)1 << 30)) {
+            *iterations = runs;
+            return elapsed / (double)runs;
+        }
+        // Aim a little past min_time in the next round
+        double scale = (elapsed > 0) ? 1.4 * min_time / elapsed : 100.0;
+        runs = (scale > 100.0) ? runs * 100 : (size_t)((double)runs * scale) + 1;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check the current engine against the table engine's codewords over size data bytes.
+ *
+ * @return 0 if encode and both decodes are correct, -1 otherwise.
+ */
+static int check_engine(const uint8_t *data, size_t size, const uint8_t *reference, const uint8_t *noisy,
+                        uint8_t *codewords, uint8_t *out)
+{
+    const char *name = hamming74_engine_name(hamming74_get_engine());
+
+    hamming74_encode_bytes(data, size, codewords);
+    if (memcmp(codewords, reference, 2 * size) != 0) {
+        fprintf(stderr, "%s: encode mismatch at %zu bytes\n", name, size);
+        return -1;
+    }
+    if (hamming74_decode_bytes(reference, size, out) != 0 || memcmp(out, data, size) != 0) {
+        fprintf(stderr, "%s: clean decode mismatch at %zu bytes\n", name, size);
+        return -1;
+    }
+
+    size_t expected = (2 * size + BENCH_ERROR_STRIDE - 1) / BENCH_ERROR_STRIDE;
+    if (hamming74_decode_bytes(noisy, size, out) != expected || memcmp(out, data, size) != 0) {
+        fprintf(stderr, "%s: decode mismatch at %zu bytes\n", name, size);
+        return -1;
+    }
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Whether engine e is available and selected by --engine.
+ */
+static int selected(int e, const char *only)
+{
+    return hamming74_engine_available((hamming74_engine_t)e) &&
+           (only == NULL || strcmp(only, hamming74_engine_name((hamming74_engine_t)e)) == 0);
+}
+
+/*-----------------------------------------------------------*/
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [--engine NAME] [--max-size BYTES] [--min-time SECONDS]\n", argv0);
+}
+
+/*-----------------------------------------------------------*/
+/*   -------------------   Main   ------------------------   */
+/*-----------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+    const char *only = NULL;
+    size_t max_size = BENCH_MAX_SIZE;
+    double min_time = 0.2;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (strcmp(argv[i], "--max-size") == 0 && i + 1 < argc) {
+            max_size = (size_t)strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            min_time = strtod(argv[++i], NULL);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    uint8_t *data = malloc(max_size);
+    uint8_t *out = malloc(max_size);
+    uint8_t *codewords = malloc(2 * max_size);
+    uint8_t *noisy = malloc(2 * max_size);
+    uint8_t *reference = malloc(2 * max_size);
+    if (data == NULL || out == NULL || codewords == NULL || noisy == NULL || reference == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    // Fixed seed so every run sees the same data and error pattern
+    srand(7);
+    for (size_t i = 0; i < max_size; i++) {
+        data[i] = (uint8_t)rand();
+    }
+    hamming74_set_engine(HAMMING74_ENGINE_TABLE);
+    hamming74_encode_bytes(data, max_size, reference);
+    memcpy(noisy, reference, 2 * max_size);
+    for (size_t i = 0; i < 2 * max_size; i += BENCH_ERROR_STRIDE) {
+        noisy[i] ^= (uint8_t)(0x40 >> (rand() % 7));
+    }
+
+    // A wrong engine would otherwise still be reported, and as fast
+    int status = 0;
+    size_t check_size = (max_size < BENCH_CHECK_SIZE) ? max_size : BENCH_CHECK_SIZE;
+    for (int e = HAMMING74_ENGINE_AUTO + 1; e < HAMMING74_ENGINE_COUNT; e++) {
+        if (selected(e, only)) {
+            hamming74_set_engine((hamming74_engine_t)e);
+            if (check_engine(data, max_size, reference, noisy, codewords, out) != 0 ||
+                check_engine(data, check_size, reference, noisy, codewords, out) != 0) {
+                status = 1;
+            }
+        }
+    }
+    if (status != 0) {
+        free(reference);
+        free(noisy);
+        free(codewords);
+        free(out);
+        free(data);
+        return status;
+    }
+
+    printf("{\n  \"benchmark\": \"hamming74\",\n  \"error_stride\": %d,\n  \"results\": [", BENCH_ERROR_STRIDE);
+    int first = 1;
+
+    for (int e = HAMMING74_ENGINE_AUTO + 1; e < HAMMING74_ENGINE_COUNT; e++) {
+        const char *name = hamming74_engine_name((hamming74_engine_t)e);
+        if (!selected(e, only)) {
+            continue;
+        }
+        hamming74_set_engine((hamming74_engine_t)e);
+
+        for (size_t size = BENCH_MIN_SIZE; size <= max_size; size = next_size(size, max_size)) {
+            for (int op = 0; op < OP_COUNT; op++) {
+                size_t iterations = 0;
+                double seconds = time_op((bench_op_t)op, data, size, codewords, noisy, out, min_time, &iterations);
+
+                printf("%s\n    {\"engine\": \"%s\", \"op\": \"%s\", \"bytes\": %zu, \"iterations\": %zu, "
+                       "\"mb_per_s\": %.2f, \"ns_per_codeword\": %.3f}",
+                       first ? "" : ",", name, op_names[op], size, iterations,
+                       (double)size / seconds * 1e-6, seconds * 1e9 / (double)(2 * size));
+                fflush(stdout);
+                first = 0;
+            }
+        }
+    }
+
+    printf("\n  ]\n}\n");
+
+    free(reference);
+    free(noisy);
+    free(codewords);
+    free(out);
+    free(data);
+    return 0;
+}
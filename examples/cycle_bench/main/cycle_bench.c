@@ -0,0 +1,326 @@
+/**
+ * @file cycle_bench.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief On-target cycle counts for every codec path.
+ *
+ * Times encode, clean decode and decode with a single-bit error in every 8th
+ * codeword with the CPU cycle counter, for a 16 B packet, 256 B and 4 KiB.
+ * Two groups of paths are measured:
+ *
+ *  - Every Hamming(7,4) engine available on the chip, plus Hamming(8,4),
+ *    with the component as built (tables in flash .rodata).
+ *  - A table kernel in IRAM running on copies of the (7,4) tables placed in
+ *    flash, DRAM and IRAM. Only the table placement differs between them.
+ *
+ * Each path is timed with warm caches and after evicting the flash cache,
+ * which is what a decode in a rarely-run ISR or task sees. Results are
+ * printed as CSV, the median of BENCH_RUNS runs with interrupts disabled.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bench_cycles.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "hamming.h"
+
+/** Median of this many runs is reported. */
+#define BENCH_RUNS 15
+
+/** Largest data size, the codeword buffers are twice that. */
+#define BENCH_MAX_SIZE 4096
+
+/** Every BENCH_ERROR_STRIDE-th codeword gets a single-bit error. */
+#define BENCH_ERROR_STRIDE 8
+
+/** Larger than the flash cache of every ESP chip (32 KiB on ESP32/S3). */
+#define BENCH_EVICT_SIZE (64 * 1024)
+
+static const size_t bench_sizes[] = {16, 256, BENCH_MAX_SIZE};
+
+/*-----------------------------------------------------------*/
+/*   ------------------   Lookup Tables   ----------------   */
+/*-----------------------------------------------------------*/
+
+/*
+ * Copies of hamming74_encode_table and hamming74_decode_table, four entries
+ * per little-endian word. The ESP32 instruction bus only allows 32-bit
+ * loads, so every placement is read through words to keep them comparable.
+ */
+#define BENCH_ENCODE_WORDS                                  \
+    {                                                       \
+        0x432A6900, 0x0F66254C, 0x335A1970, 0x7F16553C,     \
+    }
+
+#define BENCH_DECODE_WORDS                                  \
+    {                                                       \
+        0x13607000, 0x473E2550, 0x57223940, 0x07776714,     \
+        0x2B5E4930, 0x7E0E1D6E, 0x691A0979, 0x374E592C,     \
+        0x3B425520, 0x65160575, 0x72021162, 0x2752453C,     \
+        0x0B7B6B18, 0x5B2E354C, 0x4B32295C, 0x1F6C7C0C,     \
+        0x03736310, 0x53263D44, 0x433A2154, 0x17647404,     \
+        0x334A5D28, 0x6D1E0D7D, 0x7A0A196A, 0x2F5A4D34,     \
+        0x23564138, 0x76061566, 0x61120171, 0x3F465124,     \
+        0x1B687808, 0x4F362D58, 0x5F2A3148, 0x0F7F6F1C,     \
+    }
+
+static const uint32_t flash_encode_table[4] = BENCH_ENCODE_WORDS;
+static const uint32_t flash_decode_table[32] = BENCH_DECODE_WORDS;
+
+DRAM_ATTR static const uint32_t dram_encode_table[4] = BENCH_ENCODE_WORDS;
+DRAM_ATTR static const uint32_t dram_decode_table[32] = BENCH_DECODE_WORDS;
+
+IRAM_ATTR static const uint32_t iram_encode_table[4] = BENCH_ENCODE_WORDS;
+IRAM_ATTR static const uint32_t iram_decode_table[32] = BENCH_DECODE_WORDS;
+
+/** Read to push the tables and the library out of the flash cache. */
+static const uint8_t evict_buffer[BENCH_EVICT_SIZE] = {1};
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+static uint8_t bench_data[BENCH_MAX_SIZE];
+static uint8_t bench_out[BENCH_MAX_SIZE];
+static uint8_t bench_codewords[2 * BENCH_MAX_SIZE];
+static uint8_t bench_noisy[2 * BENCH_MAX_SIZE];
+
+static portMUX_TYPE bench_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/*-----------------------------------------------------------*/
+
+FORCE_INLINE_ATTR uint8_t table_byte(const uint32_t *table, uint32_t index)
+{
+    return (uint8_t)(table[index >> 2] >> (8 * (index & 3)));
+}
+
+/*-----------------------------------------------------------*/
+
+static void IRAM_ATTR placed_encode(const uint32_t *table, const uint8_t *data, size_t data_size,
+                                    uint8_t *codewords)
+{
+    for (size_t i = 0; i < data_size; i++) {
+        codewords[2 * i] = table_byte(table, data[i] >> 4);
+        codewords[2 * i + 1] = table_byte(table, data[i] & 0x0F);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void IRAM_ATTR placed_decode(const uint32_t *table, const uint8_t *codewords, size_t data_size,
+                                    uint8_t *data)
+{
+    for (size_t i = 0; i < data_size; i++) {
+        uint8_t hi = table_byte(table, codewords[2 * i] & 0x7F);
+        uint8_t lo = table_byte(table, codewords[2 * i + 1] & 0x7F);
+        data[i] = (uint8_t)(((hi & 0x0F) << 4) | (lo & 0x0F));
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void IRAM_ATTR flash_encode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    placed_encode(flash_encode_table, in, size, out);
+}
+
+static void IRAM_ATTR flash_decode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    placed_decode(flash_decode_table, in, size, out);
+}
+
+static void IRAM_ATTR dram_encode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    placed_encode(dram_encode_table, in, size, out);
+}
+
+static void IRAM_ATTR dram_decode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    placed_decode(dram_decode_table, in, size, out);
+}
+
+static void IRAM_ATTR iram_encode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    placed_encode(iram_encode_table, in, size, out);
+}
+
+static void IRAM_ATTR iram_decode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    placed_decode(iram_decode_table, in, size, out);
+}
+
+/*-----------------------------------------------------------*/
+
+static void lib74_decode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    (void)hamming74_decode_bytes(in, size, out);
+}
+
+static void lib84_decode(const uint8_t *in, size_t size, uint8_t *out)
+{
+    (void)hamming84_decode_bytes(in, size, out, NULL);
+}
+
+/*-----------------------------------------------------------*/
+
+typedef void (*bench_fn_t)(const uint8_t *in, size_t size, uint8_t *out);
+
+typedef struct {
+    const char *name;           // Engine or kernel
+    const char *tables;         // Where its tables live
+    hamming74_engine_t engine;  // Engine to select first, AUTO if unused
+    bench_fn_t encode;
+    bench_fn_t decode;
+} bench_case_t;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Touch every cache line of evict_buffer.
+ */
+static void evict_flash_cache(void)
+{
+    const volatile uint8_t *p = evict_buffer;
+    uint32_t sink = 0;
+    for (size_t i = 0; i < BENCH_EVICT_SIZE; i += 16) {
+        sink += p[i];
+    }
+    (void)sink;
+}
+
+/*-----------------------------------------------------------*/
+
+static void sort_u32(uint32_t *v, size_t n)
+{
+    for (size_t i = 1; i < n; i++) {
+        uint32_t x = v[i];
+        size_t j = i;
+        for (; j > 0 && v[j - 1] > x; j--) {
+            v[j] = v[j - 1];
+        }
+        v[j] = x;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Median cycles of one call to fn.
+ *
+ * @param cold Evict the flash cache before every run instead of warming up.
+ */
+static uint32_t measure(bench_fn_t fn, const uint8_t *in, size_t size, uint8_t *out, int cold)
+{
+    uint32_t samples[BENCH_RUNS];
+
+    for (int r = 0; r < BENCH_RUNS; r++) {
+        if (cold) {
+            evict_flash_cache();
+        } else {
+            fn(in, size, out);
+        }
+
+        portENTER_CRITICAL(&bench_lock);
+        uint32_t start = bench_cycles();
+        fn(in, size, out);
+        samples[r] = bench_cycles() - start;
+        portEXIT_CRITICAL(&bench_lock);
+    }
+
+    sort_u32(samples, BENCH_RUNS);
+    return samples[BENCH_RUNS / 2];
+}
+
+/*-----------------------------------------------------------*/
+
+static void report(const bench_case_t *c, const char *op, size_t size, int cold, uint32_t cycles)
+{
+    printf("%s,%s,%s,%u,%s,%lu,%.2f\n", c->name, c->tables, op, (unsigned)size, cold ? "cold" : "warm",
+           (unsigned long)cycles, (double)cycles / (double)size);
+}
+
+/*-----------------------------------------------------------*/
+
+static void run_case(const bench_case_t *c)
+{
+    if (c->engine != HAMMING74_ENGINE_AUTO) {
+        hamming74_set_engine(c->engine);
+    }
+    for (size_t s = 0; s < sizeof(bench_sizes) / sizeof(bench_sizes[0]); s++) {
+        size_t size = bench_sizes[s];
+
+        // Codewords and a noisy copy in this path's format
+        c->encode(bench_data, size, bench_codewords);
+        memcpy(bench_noisy, bench_codewords, 2 * size);
+        for (size_t i = 0; i < 2 * size; i += BENCH_ERROR_STRIDE) {
+            bench_noisy[i] ^= (uint8_t)(0x40 >> (i % 7));
+        }
+
+        c->decode(bench_noisy, size, bench_out);
+        if (memcmp(bench_out, bench_data, size) != 0) {
+            printf("# %s/%s: decode mismatch at %u bytes\n", c->name, c->tables, (unsigned)size);
+        }
+
+        for (int cold = 0; cold <= 1; cold++) {
+            report(c, "encode", size, cold, measure(c->encode, bench_data, size, bench_codewords, cold));
+            report(c, "decode_clean", size, cold, measure(c->decode, bench_codewords, size, bench_out, cold));
+            report(c, "decode_errors", size, cold, measure(c->decode, bench_noisy, size, bench_out, cold));
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*   -------------------   Main   ------------------------   */
+/*-----------------------------------------------------------*/
+
+void app_main(void)
+{
+    bench_cycles_init();
+
+    // Fixed xorshift sequence so every run sees the same data
+    uint32_t x = 0x2545F491u;
+    for (size_t i = 0; i < BENCH_MAX_SIZE; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        bench_data[i] = (uint8_t)x;
+    }
+
+    printf("# hamming cycle benchmark, median of %d runs, error stride %d\n", BENCH_RUNS, BENCH_ERROR_STRIDE);
+    printf("engine,tables,op,bytes,cache,cycles,cycles_per_byte\n");
+
+    for (int e = HAMMING74_ENGINE_AUTO + 1; e < HAMMING74_ENGINE_COUNT; e++) {
+        if (!hamming74_engine_available((hamming74_engine_t)e)) {
+            continue;
+        }
+        const bench_case_t c = {
+            hamming74_engine_name((hamming74_engine_t)e), "flash", (hamming74_engine_t)e,
+            hamming74_encode_bytes, lib74_decode,
+        };
+        run_case(&c);
+        vTaskDelay(1);
+    }
+
+    const bench_case_t placed[] = {
+        {"hamming84", "flash", HAMMING74_ENGINE_AUTO, hamming84_encode_bytes, lib84_decode},
+        {"placed", "flash", HAMMING74_ENGINE_AUTO, flash_encode, flash_decode},
+        {"placed", "dram", HAMMING74_ENGINE_AUTO, dram_encode, dram_decode},
+        {"placed", "iram", HAMMING74_ENGINE_AUTO, iram_encode, iram_decode},
+    };
+    for (size_t i = 0; i < sizeof(placed) / sizeof(placed[0]); i++) {
+        run_case(&placed[i]);
+        vTaskDelay(1);
+    }
+
+    hamming74_set_engine(HAMMING74_ENGINE_AUTO);
+    printf("# done\n");
+}
@@ -16,8 +16,101 @@
  * @copyright Copyright (c) 2025
  */
 
-#include <stdlib.h>
 #include "hamming.h"
+#include "hamming_private.h"
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Lookup Tables   ------------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Hamming(7,4) codeword for every 4-bit nibble.
+ *
+ * Codewords are packed into the low 7 bits, position 1 (P1) in bit 6 down to
+ * position 7 (D4) in bit 0. The nibble supplies D1 (bit 3) through D4 (bit 0).
+ */
+HAMMING_DRAM_ATTR const uint8_t hamming74_encode_table[16] = {
+    0x00, 0x69, 0x2A, 0x43, 0x4C, 0x25, 0x66, 0x0F,
+    0x70, 0x19, 0x5A, 0x33, 0x3C, 0x55, 0x16, 0x7F,
+};
+
+/**
+ * @brief Decoded nibble and syndrome for every 7-bit codeword.
+ *
+ * The low 4 bits hold the corrected nibble, bits 4..6 hold the syndrome
+ * (the 1-based position of the flipped bit, 0 when the codeword is clean).
+ */
+HAMMING_DRAM_ATTR const uint8_t hamming74_decode_table[128] = {
+    0x00, 0x70, 0x60, 0x13, 0x50, 0x25, 0x3E, 0x47,
+    0x40, 0x39, 0x22, 0x57, 0x14, 0x67, 0x77, 0x07,
+    0x30, 0x49, 0x5E, 0x2B, 0x6E, 0x1D, 0x0E, 0x7E,
+    0x79, 0x09, 0x1A, 0x69, 0x2C, 0x59, 0x4E, 0x37,
+    0x20, 0x55, 0x42, 0x3B, 0x75, 0x05, 0x16, 0x65,
+    0x62, 0x11, 0x02, 0x72, 0x3C, 0x45, 0x52, 0x27,
+    0x18, 0x6B, 0x7B, 0x0B, 0x4C, 0x35, 0x2E, 0x5B,
+    0x5C, 0x29, 0x32, 0x4B, 0x0C, 0x7C, 0x6C, 0x1F,
+    0x10, 0x63, 0x73, 0x03, 0x44, 0x3D, 0x26, 0x53,
+    0x54, 0x21, 0x3A, 0x43, 0x04, 0x74, 0x64, 0x17,
+    0x28, 0x5D, 0x4A, 0x33, 0x7D, 0x0D, 0x1E, 0x6D,
+    0x6A, 0x19, 0x0A, 0x7A, 0x34, 0x4D, 0x5A, 0x2F,
+    0x38, 0x41, 0x56, 0x23, 0x66, 0x15, 0x06, 0x76,
+    0x71, 0x01, 0x12, 0x61, 0x24, 0x51, 0x46, 0x3F,
+    0x08, 0x78, 0x68, 0x1B, 0x58, 0x2D, 0x36, 0x4F,
+    0x48, 0x31, 0x2A, 0x5F, 0x1C, 0x6F, 0x7F, 0x0F,
+};
+
+/**
+ * @brief Hamming(8,4) SECDED codeword for every 4-bit nibble.
+ *
+ * Bits 0..6 hold the Hamming(7,4) codeword, bit 7 is the extended parity bit
+ * that gives every codeword even parity.
+ */
+HAMMING_DRAM_ATTR const uint8_t hamming84_encode_table[16] = {
+    0x00, 0x69, 0xAA, 0xC3, 0xCC, 0xA5, 0x66, 0x0F,
+    0xF0, 0x99, 0x5A, 0x33, 0x3C, 0x55, 0x96, 0xFF,
+};
+
+/**
+ * @brief Decoded nibble and status for every 8-bit SECDED codeword.
+ *
+ * The low 4 bits hold the nibble (corrected if possible), bit 4 is set
+ * when a single-bit error was corrected and bit 5 when a double-bit error
+ * was detected, in which case the nibble is left uncorrected.
+ */
+HAMMING_DRAM_ATTR const uint8_t hamming84_decode_table[256] = {
+    0x00, 0x10, 0x10, 0x23, 0x10, 0x25, 0x26, 0x17,
+    0x10, 0x21, 0x22, 0x17, 0x24, 0x17, 0x17, 0x07,
+    0x10, 0x29, 0x2A, 0x1B, 0x2C, 0x1D, 0x1E, 0x2F,
+    0x28, 0x19, 0x1A, 0x2B, 0x1C, 0x2D, 0x2E, 0x17,
+    0x10, 0x21, 0x22, 0x1B, 0x24, 0x15, 0x16, 0x27,
+    0x20, 0x11, 0x12, 0x23, 0x1C, 0x25, 0x26, 0x17,
+    0x28, 0x1B, 0x1B, 0x0B, 0x1C, 0x2D, 0x2E, 0x1B,
+    0x1C, 0x29, 0x2A, 0x1B, 0x0C, 0x1C, 0x1C, 0x2F,
+    0x10, 0x21, 0x22, 0x13, 0x24, 0x1D, 0x16, 0x27,
+    0x20, 0x11, 0x1A, 0x23, 0x14, 0x25, 0x26, 0x17,
+    0x28, 0x1D, 0x1A, 0x2B, 0x1D, 0x0D, 0x2E, 0x1D,
+    0x1A, 0x29, 0x0A, 0x1A, 0x2C, 0x1D, 0x1A, 0x2F,
+    0x20, 0x11, 0x16, 0x23, 0x16, 0x25, 0x06, 0x16,
+    0x11, 0x01, 0x22, 0x11, 0x24, 0x11, 0x16, 0x27,
+    0x18, 0x29, 0x2A, 0x1B, 0x2C, 0x1D, 0x16, 0x2F,
+    0x28, 0x11, 0x1A, 0x2B, 0x1C, 0x2D, 0x2E, 0x1F,
+    0x10, 0x21, 0x22, 0x13, 0x24, 0x15, 0x1E, 0x27,
+    0x20, 0x19, 0x12, 0x23, 0x14, 0x25, 0x26, 0x17,
+    0x28, 0x19, 0x1E, 0x2B, 0x1E, 0x2D, 0x0E, 0x1E,
+    0x19, 0x09, 0x2A, 0x19, 0x2C, 0x19, 0x1E, 0x2F,
+    0x20, 0x15, 0x12, 0x23, 0x15, 0x05, 0x26, 0x15,
+    0x12, 0x21, 0x02, 0x12, 0x24, 0x15, 0x12, 0x27,
+    0x18, 0x29, 0x2A, 0x1B, 0x2C, 0x15, 0x1E, 0x2F,
+    0x28, 0x19, 0x12, 0x2B, 0x1C, 0x2D, 0x2E, 0x1F,
+    0x20, 0x13, 0x13, 0x03, 0x14, 0x25, 0x26, 0x13,
+    0x14, 0x21, 0x22, 0x13, 0x04, 0x14, 0x14, 0x27,
+    0x18, 0x29, 0x2A, 0x13, 0x2C, 0x1D, 0x1E, 0x2F,
+    0x28, 0x19, 0x1A, 0x2B, 0x14, 0x2D, 0x2E, 0x1F,
+    0x18, 0x21, 0x22, 0x13, 0x24, 0x15, 0x16, 0x27,
+    0x20, 0x11, 0x12, 0x23, 0x14, 0x25, 0x26, 0x1F,
+    0x08, 0x18, 0x18, 0x2B, 0x18, 0x2D, 0x2E, 0x1F,
+    0x18, 0x29, 0x2A, 0x1F, 0x2C, 0x1F, 0x1F, 0x0F,
+};
 
 /*-----------------------------------------------------------*/
 /*   --------------   Helper Functions   -----------------   */
@@ -31,16 +124,14 @@
  * @param p The index of the parity check (0 for P1, 1 for P2, etc.).
  * @return The calculated parity (0 or 1).
  */
-static int parity_check(int n, int *data, int p)
+static int HAMMING_IRAM_ATTR parity_check(int n, const int *data, int p)
 {
     int mask = 1 << p;  // 1-based position of the parity bit (2^p)
     int sum = 0;
     // Iterate over all bits starting from the current parity bit's position
     for (int i = mask - 1; i < n; i++) {
-        // Check if the (i+1)-th bit has the p-th bit set (1-based position)
-        if (((i + 1) & mask) != 0) {
-            sum ^= data[i];
-        }
+        // Only count the (i+1)-th bit if it has the p-th bit set (1-based position)
+        sum ^= data[i] & (((i + 1) >> p) & 1);
     }
     return sum;
 }
@@ -56,20 +147,13 @@ static int parity_check(int n, int *data, int p)
  * @param encoded_data Pointer to the array containing the encoded Hamming code data.
  * @return The calculated syndrome, indicates position of single-bit error.
  */
-static int calculate_syndrome(int n, int *encoded_data)
+static int HAMMING_IRAM_ATTR calculate_syndrome(int n, const int *encoded_data)
 {
     int syndrome = 0;
-    int p = 0;
-    // Determine the number of parity bits needed (r) such that 2^r >= n + r + 1
-    // For simplicity, iterate while 2^p <= n
-    while ((1 << p) <= n) {
-        int parity_pos = (1 << p) - 1;  // 0-based position of parity bit
-        if (parity_pos >= n) break;
-        // Compute the parity check for this p
-        int check = parity_check(n, encoded_data, p);
-        // If the check is non-zero, set the corresponding syndrome bit
-        syndrome |= (check << p);
-        p++;
+    // One parity check per parity bit, i.e. for every p with 2^p <= n, so the
+    // loop count only depends on n and never on the data
+    for (int p = 0; (1 << p) <= n; p++) {
+        syndrome |= parity_check(n, encoded_data, p) << p;
     }
     return syndrome;
 }
@@ -82,7 +166,7 @@ static int calculate_syndrome(int n, int *encoded_data)
  * @param data An integer array of size 4 containing the 4-bit input nibble.
  * @param encoded_data An integer array of size 7 that will be populated with the Hamming(7,4) encoded data.
  */
-static void hamming_encode_nibble(const int data[4], int encoded_data[7])
+static void HAMMING_IRAM_ATTR hamming_encode_nibble(const int data[4], int encoded_data[7])
 {
     // For a 4-bit nibble, the number of parity bits is fixed at 3 (7 = 4 data bits + 3 parity bits)
     int n = 7;
@@ -119,70 +203,304 @@ static void hamming_encode_nibble(const int data[4], int encoded_data[7])
  * The expected arrangement for Hamming(7,4) is:
  * - Data bits are located at indices 2, 4, 5, and 6 of the encoded_data array.
  *
+ * The correction is applied to the decoded copy, encoded_data is never written.
+ *
  * @param encoded_data An integer array of length 7 containing the encoded nibble bits.
  * @param decoded_data An integer array of length 4 where the resulting decoded (and corrected)
  *                     4-bit data is stored.
+ * @return The syndrome, 0 if no error was detected, otherwise the 1-based position
+ *         of the corrected bit.
  */
-static void hamming_decode_nibble(int encoded_data[7], int decoded_data[4])
+static int HAMMING_IRAM_ATTR hamming_decode_nibble(const int encoded_data[7], int decoded_data[4])
 {
+    HAMMING_DRAM_ATTR static const int data_index[4] = {2, 4, 5, 6};
+
     // Calculate the syndrome to detect errors over 7 bits
     int syndrome = calculate_syndrome(7, encoded_data);
 
-    // Correct the error if syndrome is non-zero
-    if (syndrome != 0) {
-        int error_pos = syndrome - 1;  // Convert to 0-based index
-        if (error_pos < 7) {
-            encoded_data[error_pos] ^= 1;  // Flip the incorrect bit
-        }
+    // Flip the data bit the syndrome points at (0-based index syndrome - 1)
+    for (int i = 0; i < 4; i++) {
+        decoded_data[i] = encoded_data[data_index[i]] ^ (syndrome - 1 == data_index[i]);
     }
 
-    // For Hamming(7,4), the data bits are at indices 2, 4, 5, and 6.
-    decoded_data[0] = encoded_data[2];
-    decoded_data[1] = encoded_data[4];
-    decoded_data[2] = encoded_data[5];
-    decoded_data[3] = encoded_data[6];
+    return syndrome;
 }
 
 /*-----------------------------------------------------------*/
-/*  -----------------   API Functions    -----------------   */
+/*  -----------------   Codec Kernels    -----------------   */
 /*-----------------------------------------------------------*/
 
-void hamming_encode_generic(const void *data, size_t data_size, int *out_bits)
+#if HAMMING_HAVE_SCALAR
+
+void HAMMING_IRAM_ATTR hamming74_scalar_encode(const uint8_t *data, size_t data_size, uint8_t *codewords)
 {
-    // Treat data as a stream of bytes.
-    // Each byte contains 2 nibbles, and each nibble (4 bits) is encoded into 7 bits.
-    const unsigned char *bytes = (const unsigned char*)data;
-    size_t nibble_count = data_size * 2;  // Two nibbles per byte
+    for (size_t i = 0; i < 2 * data_size; i++) {
+        uint8_t nibble = (i % 2 == 0) ? (data[i / 2] >> 4) : (data[i / 2] & 0x0F);
+        int block[4] = {(nibble >> 3) & 1, (nibble >> 2) & 1, (nibble >> 1) & 1, nibble & 1};
+        int encoded[7];
+        hamming_encode_nibble(block, encoded);
 
-    for (size_t i = 0; i < nibble_count; i++) {
-        int block[4];
-        unsigned char nibble;
+        uint8_t codeword = 0;
+        for (int j = 0; j < 7; j++) {
+            codeword = (uint8_t)((codeword << 1) | encoded[j]);
+        }
+        codewords[i] = codeword;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_scalar_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                                 uint8_t *syndromes)
+{
+    size_t corrected = 0;
 
-        // Extract high nibble for even indices, low nibble for odd indices
-        if (i % 2 == 0) {
-            nibble = bytes[i / 2] >> 4;
-        } else {
-            nibble = bytes[i / 2] & 0x0F;
+    for (size_t i = 0; i < data_size; i++) {
+        uint8_t byte = 0;
+        for (int h = 0; h < 2; h++) {
+            int encoded[7];
+            for (int j = 0; j < 7; j++) {
+                encoded[j] = (codewords[2 * i + h] >> (6 - j)) & 1;
+            }
+            int block[4];
+            int syndrome = hamming_decode_nibble(encoded, block);
+            corrected += (syndrome != 0);
+            if (syndromes != NULL) {
+                syndromes[2 * i + h] = (uint8_t)syndrome;
+            }
+            byte = (uint8_t)((byte << 4) | (block[0] << 3) | (block[1] << 2) | (block[2] << 1) | block[3]);
         }
+        data[i] = byte;
+    }
 
-        // Convert nibble to a 4-element bit array.
-        block[0] = (nibble >> 3) & 1;
-        block[1] = (nibble >> 2) & 1;
-        block[2] = (nibble >> 1) & 1;
-        block[3] = nibble & 1;
+    return corrected;
+}
 
-        int encoded[7];
-        hamming_encode_nibble(block, encoded);
+/*-----------------------------------------------------------*/
 
-        // Place the encoded 7 bits into the output array.
+int HAMMING_IRAM_ATTR hamming74_scalar_is_clean(const uint8_t *codewords, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        int encoded[7];
         for (int j = 0; j < 7; j++) {
-            out_bits[i * 7 + j] = encoded[j];
+            encoded[j] = (codewords[i] >> (6 - j)) & 1;
+        }
+        if (calculate_syndrome(7, encoded) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+#endif  // HAMMING_HAVE_SCALAR
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming74_table_encode(const uint8_t *data, size_t data_size, uint8_t *codewords)
+{
+    // High nibble first, matching hamming_encode_generic()
+    for (size_t i = 0; i < data_size; i++) {
+        codewords[2 * i] = hamming74_encode_table[data[i] >> 4];
+        codewords[2 * i + 1] = hamming74_encode_table[data[i] & 0x0F];
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_table_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                                uint8_t *syndromes)
+{
+    size_t corrected = 0;
+
+    for (size_t i = 0; i < data_size;) {
+        // Most words are clean: gather their data bits and skip the lookups
+        if (i + 4 <= data_size) {
+            uint64_t w = hamming_load64_le(codewords + 2 * i);
+            if (hamming74_dirty64(w) == 0) {
+                uint32_t bytes = hamming_gather_nibbles64(w);
+                for (int k = 0; k < 4; k++) {
+                    data[i + k] = (uint8_t)(bytes >> (8 * k));
+                }
+                if (syndromes != NULL) {
+                    hamming_store64_le(syndromes + 2 * i, 0);
+                }
+                i += 4;
+                continue;
+            }
         }
+
+        // Dirty word or tail: decode the next 4 bytes (or fewer) one codeword at a time
+        size_t end = (data_size - i < 4) ? data_size : i + 4;
+        for (; i < end; i++) {
+            // Bit 7 is not part of the codeword, mask it so the lookup stays in bounds
+            uint8_t hi = hamming74_decode_table[codewords[2 * i] & 0x7F];
+            uint8_t lo = hamming74_decode_table[codewords[2 * i + 1] & 0x7F];
+            data[i] = (uint8_t)(((hi & 0x0F) << 4) | (lo & 0x0F));
+
+            // The syndrome lives in bits 4..6 of every table entry
+            corrected += (hi >> 4 != 0) + (lo >> 4 != 0);
+            if (syndromes != NULL) {
+                syndromes[2 * i] = hi >> 4;
+                syndromes[2 * i + 1] = lo >> 4;
+            }
+        }
+    }
+
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming74_swar_is_clean(const uint8_t *codewords, size_t count)
+{
+    uint64_t dirty = 0;
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8) {
+        dirty |= hamming74_dirty64(hamming_load64_le(codewords + i));
+    }
+    for (; i < count; i++) {
+        dirty |= hamming74_decode_table[codewords[i] & 0x7F] >> 4;
+    }
+
+    return dirty == 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Branch-free decode of 8 codewords loaded little-endian.
+ *
+ * The data bits are XORed with a correction mask computed from the syndrome
+ * planes, D1..D4 flip for syndromes 3, 5, 6 and 7. No branch or memory
+ * access depends on the codewords.
+ *
+ * @param w The codewords, bit 7 of every byte is ignored.
+ * @param syndrome Receives the syndrome of every codeword, one per byte.
+ * @param corrected Receives the number of codewords with a non-zero syndrome.
+ * @return The 4 data bytes in bits 0..31, first byte in bits 0..7.
+ */
+HAMMING_INLINE uint32_t consttime_decode64(uint64_t w, uint64_t *syndrome, unsigned *corrected)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    uint64_t s1 = hamming_byte_parity64(w & 0x5555555555555555ULL);
+    uint64_t s2 = hamming_byte_parity64(w & 0x3333333333333333ULL);
+    uint64_t s4 = hamming_byte_parity64(w & 0x0F0F0F0F0F0F0F0FULL);
+
+    uint64_t fix = ((s1 & s2 & (s4 ^ ones)) << 4) | ((s1 & (s2 ^ ones) & s4) << 2) |
+                   (((s1 ^ ones) & s2 & s4) << 1) | (s1 & s2 & s4);
+
+    *syndrome = s1 | (s2 << 1) | (s4 << 2);
+    // Sum the flag bits of all bytes into the top byte, a popcount may be a table lookup
+    *corrected = (unsigned)(((s1 | s2 | s4) * ones) >> 56);
+    return hamming_gather_nibbles64(w ^ fix);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_consttime_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                                   uint8_t *syndromes)
+{
+    size_t corrected = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= data_size; i += 4) {
+        uint64_t s;
+        unsigned dirty;
+        uint32_t bytes = consttime_decode64(hamming_load64_le(codewords + 2 * i), &s, &dirty);
+        corrected += dirty;
+        if (syndromes != NULL) {
+            hamming_store64_le(syndromes + 2 * i, s);
+        }
+        for (int k = 0; k < 4; k++) {
+            data[i + k] = (uint8_t)(bytes >> (8 * k));
+        }
+    }
+
+    // The last 1 to 3 bytes take the same path, padded with clean zero codewords
+    if (i < data_size) {
+        size_t n = data_size - i;
+        uint8_t pad[8] = {0};
+        for (size_t k = 0; k < 2 * n; k++) {
+            pad[k] = codewords[2 * i + k];
+        }
+
+        uint64_t s;
+        unsigned dirty;
+        uint32_t bytes = consttime_decode64(hamming_load64_le(pad), &s, &dirty);
+        corrected += dirty;
+        for (size_t k = 0; k < n; k++) {
+            data[i + k] = (uint8_t)(bytes >> (8 * k));
+            if (syndromes != NULL) {
+                syndromes[2 * (i + k)] = (uint8_t)(s >> (16 * k));
+                syndromes[2 * (i + k) + 1] = (uint8_t)(s >> (16 * k + 8));
+            }
+        }
+    }
+
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming84_table_encode(const uint8_t *data, size_t data_size, uint8_t *codewords)
+{
+    for (size_t i = 0; i < data_size; i++) {
+        codewords[2 * i] = hamming84_encode_table[data[i] >> 4];
+        codewords[2 * i + 1] = hamming84_encode_table[data[i] & 0x0F];
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming84_table_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                              hamming_stats_t *stats)
+{
+    size_t corrected = 0;
+    size_t uncorrectable = 0;
+
+    for (size_t i = 0; i < data_size; i++) {
+        uint8_t hi = hamming84_decode_table[codewords[2 * i]];
+        uint8_t lo = hamming84_decode_table[codewords[2 * i + 1]];
+        data[i] = (uint8_t)(((hi & 0x0F) << 4) | (lo & 0x0F));
+
+        corrected += ((hi & HAMMING84_CORRECTED) != 0) + ((lo & HAMMING84_CORRECTED) != 0);
+        uncorrectable += ((hi & HAMMING84_UNCORRECTABLE) != 0) + ((lo & HAMMING84_UNCORRECTABLE) != 0);
+    }
+
+    stats->corrected += corrected;
+    stats->uncorrectable += uncorrectable;
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming_extract_bytes(const uint8_t *codewords, size_t data_size, uint8_t *data)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= data_size; i += 4) {
+        uint32_t bytes = hamming_gather_nibbles64(hamming_load64_le(codewords + 2 * i));
+        data[i] = (uint8_t)bytes;
+        data[i + 1] = (uint8_t)(bytes >> 8);
+        data[i + 2] = (uint8_t)(bytes >> 16);
+        data[i + 3] = (uint8_t)(bytes >> 24);
+    }
+
+    for (; i < data_size; i++) {
+        uint8_t hi = codewords[2 * i];
+        uint8_t lo = codewords[2 * i + 1];
+        data[i] = (uint8_t)(((((hi >> 1) & 8) | (hi & 7)) << 4) | ((lo >> 1) & 8) | (lo & 7));
     }
 }
 
-void hamming_encode_74(const int *input_bits, int total_bits, int *out_bits)
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming_encode_74(const int *input_bits, int total_bits, int *out_bits)
 {
+    HAMMING_COUNT_START(t0);
+
     // total_bits should be a multiple of 4
     for (int i = 0; i < total_bits; i += 4) {
         int block[4] = {
@@ -196,19 +514,28 @@ void hamming_encode_74(const int *input_bits, int total_bits, int *out_bits)
             out_bits[(i / 4) * 7 + j] = encoded[j];
         }
     }
+
+    HAMMING_COUNT_ENCODE(t0, (size_t)(total_bits / 4));
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_encoded_bits_74(int total_bits)
+{
+    return total_bits / 4 * 7;
 }
 
 /*-----------------------------------------------------------*/
 
-void hamming_decode_74(const int *in_bits, int total_bits, int *decoded_bits)
+int HAMMING_IRAM_ATTR hamming_decode_74(const int *in_bits, int total_bits, int *decoded_bits)
 {
+    HAMMING_COUNT_START(t0);
+    int corrected = 0;
+
     for (int i = 0; i < total_bits / 4; i++) {
-        int encoded[7];
-        for (int j = 0; j < 7; j++) {
-            encoded[j] = in_bits[i * 7 + j];
-        }
+        // Decode straight from the source, block is complete before anything is written
         int block[4];
-        hamming_decode_nibble(encoded, block);
+        corrected += (hamming_decode_nibble(in_bits + i * 7, block) != 0);
 
         // Copy back 4 decoded bits
         decoded_bits[i * 4 + 0] = block[0];
@@ -216,6 +543,195 @@ void hamming_decode_74(const int *in_bits, int total_bits, int *decoded_bits)
         decoded_bits[i * 4 + 2] = block[2];
         decoded_bits[i * 4 + 3] = block[3];
     }
+
+    HAMMING_COUNT_DECODE(t0, (size_t)(total_bits / 4), (size_t)corrected, 0);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming_decode_74_inplace(int *bits, int total_bits)
+{
+    // Codeword i is read from [7i, 7i + 7) before its data goes to [4i, 4i + 4)
+    return hamming_decode_74(bits, total_bits, bits);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_encoded_size(size_t data_size)
+{
+    return 2 * data_size;
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming74_encode_bytes(const uint8_t *data, size_t data_size, uint8_t *codewords)
+{
+    HAMMING_COUNT_START(t0);
+    hamming74_engine_ops()->encode(data, data_size, codewords);
+    HAMMING_COUNT_ENCODE(t0, 2 * data_size);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_decode_bytes(const uint8_t *codewords, size_t data_size, uint8_t *data)
+{
+    return hamming74_decode_bytes_ex(codewords, data_size, data, NULL);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_decode_bytes_ex(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                                   uint8_t *syndromes)
+{
+    HAMMING_COUNT_START(t0);
+    size_t corrected = hamming74_engine_ops()->decode(codewords, data_size, data, syndromes);
+    HAMMING_COUNT_DECODE(t0, 2 * data_size, corrected, 0);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_decode_bytes_inplace(uint8_t *buf, size_t data_size)
+{
+    return hamming74_decode_bytes_ex(buf, data_size, buf, NULL);
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming_encode_generic(const void *data, size_t data_size, uint8_t *codewords)
+{
+    // Treat data as a stream of bytes, each byte yields two codewords (high nibble first)
+    hamming74_encode_bytes((const uint8_t *)data, data_size, codewords);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming_decode_generic(const uint8_t *codewords, size_t data_size, void *data)
+{
+    return hamming74_decode_bytes(codewords, data_size, (uint8_t *)data);
 }
 
-/*-----------------------------------------------------------*/
\ No newline at end of file
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming84_encode_bytes(const uint8_t *data, size_t data_size, uint8_t *codewords)
+{
+    HAMMING_COUNT_START(t0);
+    hamming84_table_encode(data, data_size, codewords);
+    HAMMING_COUNT_ENCODE(t0, 2 * data_size);
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming84_decode_bytes(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                             hamming_stats_t *stats)
+{
+    HAMMING_COUNT_START(t0);
+    hamming_stats_t local = {0, 0};
+    hamming84_table_decode(codewords, data_size, data, &local);
+    HAMMING_COUNT_DECODE(t0, 2 * data_size, local.corrected, local.uncorrectable);
+
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+    return (local.uncorrectable != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming84_decode_bytes_inplace(uint8_t *buf, size_t data_size, hamming_stats_t *stats)
+{
+    return hamming84_decode_bytes(buf, data_size, buf, stats);
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming84_is_clean(const uint8_t *codewords, size_t count)
+{
+    uint64_t dirty = 0;
+    size_t i = 0;
+
+    // A codeword is clean if P1, P2, P4 and the overall parity all check out
+    for (; i + 8 <= count; i += 8) {
+        uint64_t w = hamming_load64_le(codewords + i);
+        dirty |= hamming74_dirty64(w) | hamming_byte_parity64(w);
+    }
+
+    for (; i < count; i++) {
+        dirty |= hamming84_decode_table[codewords[i]] & (HAMMING84_CORRECTED | HAMMING84_UNCORRECTABLE);
+    }
+
+    return dirty == 0;
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming74_is_clean(const uint8_t *codewords, size_t count)
+{
+    return hamming74_engine_ops()->is_clean(codewords, count);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_correct_bytes(uint8_t *codewords, size_t count)
+{
+    HAMMING_COUNT_START(t0);
+    size_t corrected = 0;
+
+    for (size_t i = 0; i < count; i += 8) {
+        size_t n = (count - i < 8) ? count - i : 8;
+
+        // Syndrome-only check of 8 codewords at once, most words are clean
+        if (n == 8) {
+            if (hamming74_dirty64(hamming_load64_le(codewords + i)) == 0) {
+                continue;
+            }
+        }
+
+        for (size_t j = i; j < i + n; j++) {
+            uint8_t syndrome = hamming74_decode_table[codewords[j] & 0x7F] >> 4;
+            if (syndrome != 0) {
+                codewords[j] ^= (uint8_t)(0x80 >> syndrome);
+                corrected++;
+            }
+        }
+    }
+
+    HAMMING_COUNT_DECODE(t0, count, corrected, 0);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+int HAMMING_IRAM_ATTR hamming84_correct_bytes(uint8_t *codewords, size_t count, hamming_stats_t *stats)
+{
+    HAMMING_COUNT_START(t0);
+    hamming_stats_t local = {0, 0};
+
+    for (size_t i = 0; i < count; i += 8) {
+        size_t n = (count - i < 8) ? count - i : 8;
+
+        if (n == 8 && hamming84_is_clean(codewords + i, 8)) {
+            continue;
+        }
+
+        for (size_t j = i; j < i + n; j++) {
+            uint8_t entry = hamming84_decode_table[codewords[j]];
+            if (entry & HAMMING84_CORRECTED) {
+                codewords[j] = hamming84_encode_table[entry & 0x0F];
+                local.corrected++;
+            }
+            local.uncorrectable += (entry & HAMMING84_UNCORRECTABLE) != 0;
+        }
+    }
+
+    HAMMING_COUNT_DECODE(t0, count, local.corrected, local.uncorrectable);
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+    return (local.uncorrectable != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------*/
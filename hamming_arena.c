@@ -0,0 +1,136 @@
+/**
+ * @file hamming_arena.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Caller-provided scratch arena for codec output buffers.
+ *
+ * An arena hands out HAMMING_ARENA_ALIGN aligned slices of one buffer, which
+ * can be static, on the stack or, through hamming_arena_create_dma(), in
+ * DMA-capable memory. Encoding straight into an arena slice lets SPI and I2S
+ * drivers send the codewords without a bounce-buffer copy.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "hamming_private.h"
+
+#if defined(ESP_PLATFORM)
+#include "esp_heap_caps.h"
+#endif
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Round size up to a multiple of HAMMING_ARENA_ALIGN.
+ */
+static inline size_t align_up(size_t size)
+{
+    return (size + HAMMING_ARENA_ALIGN - 1) & ~(size_t)(HAMMING_ARENA_ALIGN - 1);
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+void hamming_arena_init(hamming_arena_t *arena, void *buffer, size_t size)
+{
+    // Skip to the first aligned byte, callers may pass any buffer
+    uintptr_t start = (uintptr_t)buffer;
+    size_t skip = (size_t)(align_up(start) - start);
+
+    arena->base = (uint8_t *)buffer + (skip < size ? skip : size);
+    arena->size = (skip < size) ? size - skip : 0;
+    arena->used = 0;
+    arena->owned = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_arena_create_dma(hamming_arena_t *arena, size_t size)
+{
+    size = align_up(size);
+#if defined(ESP_PLATFORM)
+    void *buffer = heap_caps_aligned_alloc(HAMMING_ARENA_ALIGN, size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+#else
+    void *buffer = aligned_alloc(HAMMING_ARENA_ALIGN, size);
+#endif
+    if (buffer == NULL) {
+        return -1;
+    }
+
+    hamming_arena_init(arena, buffer, size);
+    arena->owned = 1;
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_arena_destroy(hamming_arena_t *arena)
+{
+    if (arena->owned) {
+#if defined(ESP_PLATFORM)
+        heap_caps_free(arena->base);
+#else
+        free(arena->base);
+#endif
+    }
+    arena->base = NULL;
+    arena->size = 0;
+    arena->used = 0;
+    arena->owned = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+void *hamming_arena_alloc(hamming_arena_t *arena, size_t size)
+{
+    size_t need = align_up(size);
+    if (need < size || need > arena->size - arena->used) {
+        return NULL;
+    }
+
+    void *slice = arena->base + arena->used;
+    arena->used += need;
+    return slice;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_arena_reset(hamming_arena_t *arena)
+{
+    arena->used = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+uint8_t *hamming74_encode_arena(hamming_arena_t *arena, hamming74_format_t format,
+                                const uint8_t *data, size_t data_size, size_t *encoded_size)
+{
+    size_t size = (format == HAMMING74_FORMAT_PACKED) ? hamming74_packed_size(data_size)
+                                                      : hamming74_encoded_size(data_size);
+    uint8_t *out = hamming_arena_alloc(arena, size);
+    if (out == NULL) {
+        return NULL;
+    }
+
+    if (format == HAMMING74_FORMAT_PACKED) {
+        hamming74_encode_packed(data, data_size, out);
+    } else {
+        hamming74_encode_bytes(data, data_size, out);
+    }
+
+    if (encoded_size != NULL) {
+        *encoded_size = size;
+    }
+    return out;
+}
+
+/*-----------------------------------------------------------*/
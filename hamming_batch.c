@@ -0,0 +1,254 @@
+/**
+ * @file hamming_batch.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Batched decoding of many small frames.
+ *
+ * The engine decodes the whole vectors of every Hamming(7,4) frame in
+ * place. What is left of each frame, fewer bytes than one vector, would
+ * otherwise go through the scalar tail of every call, so those tails are
+ * copied into a staging buffer of up to BATCH_STAGE data bytes, decoded
+ * there by a single engine call and copied out again. The engine reports the
+ * corrections of the whole stage only, so when it found any, the tails of
+ * that stage are recounted from their codewords, which is rare on a working
+ * link.
+ *
+ * Workers claim BATCH_CLAIM frames at a time from a shared atomic cursor,
+ * so frames of very different sizes still balance out. Every worker keeps
+ * its own statistics that are summed after the join.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "hamming_batch.h"
+#include "hamming_private.h"
+
+/** Data bytes of a staging buffer, 1 KiB of codewords on the stack of each worker. */
+#define BATCH_STAGE 512
+
+/** Frames claimed by a worker at a time. */
+#define BATCH_CLAIM 64
+
+/** Tails are only staged for the vector engines, without them the stage is left out. */
+#define BATCH_STAGING (HAMMING_HAVE_X86_SIMD || HAMMING_HAVE_NEON)
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Job Description   ------------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief One batch call, shared by all workers.
+ *
+ * Each worker only writes the frames it claimed and its own entry of stats.
+ */
+typedef struct {
+    hamming_batch_frame_t *frames;
+    size_t count;
+    hamming_frame_code_t code;
+    const hamming74_engine_ops_t *ops;
+    size_t vector;        // vector_bytes(ops)
+    _Atomic size_t next;  // First unclaimed frame
+    hamming_stats_t stats[HAMMING_PARALLEL_MAX_THREADS];
+} batch_t;
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+#if BATCH_STAGING
+
+/**
+ * @brief Number of codewords with a non-zero syndrome.
+ */
+static size_t count_corrected(const uint8_t *codewords, size_t count)
+{
+    size_t corrected = 0;
+    for (size_t i = 0; i < count; i++) {
+        corrected += (hamming74_decode_table[codewords[i] & 0x7F] >> 4) != 0;
+    }
+    return corrected;
+}
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Record the outcome of a frame and add it to the worker's stats.
+ */
+static void finish_frame(hamming_batch_frame_t *f, size_t corrected, size_t uncorrectable, hamming_stats_t *stats)
+{
+    f->stats.corrected = corrected;
+    f->stats.uncorrectable = uncorrectable;
+    if (uncorrectable != 0) {
+        f->status = HAMMING_FRAME_UNCORRECTABLE;
+    } else {
+        f->status = (corrected != 0) ? HAMMING_FRAME_CORRECTED : HAMMING_FRAME_CLEAN;
+    }
+    stats->corrected += corrected;
+    stats->uncorrectable += uncorrectable;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Data bytes the engine decodes per vector, a power of 2.
+ *
+ * Shorter runs go through the scalar tail of the vector engines. The other
+ * engines handle short clean runs about as fast as long ones, so staging
+ * would only add copies.
+ */
+static size_t vector_bytes(const hamming74_engine_ops_t *ops)
+{
+    switch (ops->id) {
+    case HAMMING74_ENGINE_SSSE3:
+    case HAMMING74_ENGINE_AVX2:  // Finishes its last 16 to 31 bytes with SSSE3
+    case HAMMING74_ENGINE_NEON:
+        return 16;
+    default:
+        return 1;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if BATCH_STAGING
+
+/**
+ * @brief Decode the staged tails of frames [first, end) and finish those frames.
+ */
+static void flush_stage(const batch_t *b, uint8_t *stage, size_t fill, size_t first, size_t end,
+                        hamming_stats_t *stats)
+{
+    size_t dirty = (fill > 0) ? b->ops->decode(stage, fill, stage, NULL) : 0;
+
+    // Scatter, counting from the codewords before an in-place frame overwrites them
+    const uint8_t *src = stage;
+    for (size_t i = first; i < end; i++) {
+        hamming_batch_frame_t *f = &b->frames[i];
+        size_t bulk = f->size & ~(b->vector - 1);
+        size_t tail = f->size - bulk;
+        size_t corrected = f->stats.corrected;
+        if (dirty != 0) {
+            corrected += count_corrected(f->codewords + 2 * bulk, 2 * tail);
+        }
+        memcpy(f->data + bulk, src, tail);
+        finish_frame(f, corrected, 0, stats);
+        src += tail;
+    }
+}
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Decode frames [first, end) of a batch.
+ */
+static void decode_range(batch_t *b, size_t first, size_t end, hamming_stats_t *stats)
+{
+    if (b->code == HAMMING_FRAME_84) {
+        // SECDED has no vector engine, so there is nothing to gain from staging
+        for (size_t i = first; i < end; i++) {
+            hamming_batch_frame_t *f = &b->frames[i];
+            hamming_stats_t local = {0, 0};
+            hamming84_table_decode(f->codewords, f->size, f->data, &local);
+            finish_frame(f, local.corrected, local.uncorrectable, stats);
+        }
+        return;
+    }
+    if (b->vector == 1) {
+        for (size_t i = first; i < end; i++) {
+            hamming_batch_frame_t *f = &b->frames[i];
+            finish_frame(f, b->ops->decode(f->codewords, f->size, f->data, NULL), 0, stats);
+        }
+        return;
+    }
+
+#if BATCH_STAGING
+
+    // The engine decodes in place, so the data bytes overwrite the front of the codewords
+    uint8_t stage[2 * BATCH_STAGE];
+    size_t fill = 0;
+    size_t pending = first;
+
+    for (size_t i = first; i < end; i++) {
+        hamming_batch_frame_t *f = &b->frames[i];
+        size_t bulk = f->size & ~(b->vector - 1);
+        size_t tail = f->size - bulk;
+
+        // Whole vectors in place, the corrections of the tail are added when the stage is flushed
+        f->stats.corrected = (bulk > 0) ? b->ops->decode(f->codewords, bulk, f->data, NULL) : 0;
+
+        if (fill + tail > BATCH_STAGE) {
+            flush_stage(b, stage, fill, pending, i, stats);
+            fill = 0;
+            pending = i;
+        }
+        memcpy(stage + 2 * fill, f->codewords + 2 * bulk, 2 * tail);
+        fill += tail;
+    }
+    flush_stage(b, stage, fill, pending, end, stats);
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Claim and decode groups of frames until the batch is done.
+ */
+static void work(void *ctx, unsigned worker)
+{
+    batch_t *b = (batch_t *)ctx;
+
+    for (;;) {
+        size_t first = atomic_fetch_add_explicit(&b->next, BATCH_CLAIM, memory_order_relaxed);
+        if (first >= b->count) {
+            break;
+        }
+        size_t end = (b->count - first < BATCH_CLAIM) ? b->count : first + BATCH_CLAIM;
+        decode_range(b, first, end, &b->stats[worker]);
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+int hamming_batch_decode(hamming_batch_frame_t *frames, size_t count, hamming_frame_code_t code,
+                         unsigned threads, hamming_stats_t *stats)
+{
+    HAMMING_COUNT_START(t0);
+    const hamming74_engine_ops_t *ops = hamming74_engine_ops();
+    batch_t b = {frames, count, code, ops, vector_bytes(ops), 0, {{0, 0}}};
+
+    unsigned workers = hamming_parallel_run(work, &b, threads, (count + BATCH_CLAIM - 1) / BATCH_CLAIM);
+
+    hamming_stats_t local = {0, 0};
+    for (unsigned t = 0; t < workers; t++) {
+        local.corrected += b.stats[t].corrected;
+        local.uncorrectable += b.stats[t].uncorrectable;
+    }
+
+#if HAMMING_HAVE_COUNTERS
+    size_t codewords = 0;
+    for (size_t i = 0; i < count; i++) {
+        codewords += 2 * frames[i].size;
+    }
+    HAMMING_COUNT_DECODE(t0, codewords, local.corrected, local.uncorrectable);
+#endif
+
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+    return (local.uncorrectable != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------*/
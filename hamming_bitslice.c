@@ -0,0 +1,247 @@
+/**
+ * @file hamming_bitslice.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Bit-sliced Hamming(7,4) codec kernels.
+ *
+ * A block of 64 data bytes is transposed so that every bit position of the
+ * block becomes its own 64-bit word (one bit per byte). The parity and
+ * syndrome words for 64 codewords are then plain XORs of those words, and
+ * the result is transposed back into one codeword per byte.
+ *
+ * @note
+ *  Output is bit-identical to the table kernels in hamming.c. Input that does
+ *  not fill a whole block is handed to the table kernels.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_private.h"
+
+#if HAMMING_HAVE_BITSLICE
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/** Data bytes per bit-sliced block (128 nibbles, 128 codewords). */
+#define BITSLICE_BLOCK 64
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Interleave two 32-bit halves: bit k of the low half moves to bit 2k,
+ *        bit k of the high half moves to bit 2k+1.
+ */
+HAMMING_INLINE uint64_t shuffle64(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 16)) & 0x00000000FFFF0000ULL;
+    x ^= t ^ (t << 16);
+    t = (x ^ (x >> 8)) & 0x0000FF000000FF00ULL;
+    x ^= t ^ (t << 8);
+    t = (x ^ (x >> 4)) & 0x00F000F000F000F0ULL;
+    x ^= t ^ (t << 4);
+    t = (x ^ (x >> 2)) & 0x0C0C0C0C0C0C0C0CULL;
+    x ^= t ^ (t << 2);
+    t = (x ^ (x >> 1)) & 0x2222222222222222ULL;
+    x ^= t ^ (t << 1);
+    return x;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Inverse of shuffle64(): even bits to the low half, odd bits to the high half.
+ */
+HAMMING_INLINE uint64_t unshuffle64(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 1)) & 0x2222222222222222ULL;
+    x ^= t ^ (t << 1);
+    t = (x ^ (x >> 2)) & 0x0C0C0C0C0C0C0C0CULL;
+    x ^= t ^ (t << 2);
+    t = (x ^ (x >> 4)) & 0x00F000F000F000F0ULL;
+    x ^= t ^ (t << 4);
+    t = (x ^ (x >> 8)) & 0x0000FF000000FF00ULL;
+    x ^= t ^ (t << 8);
+    t = (x ^ (x >> 16)) & 0x00000000FFFF0000ULL;
+    x ^= t ^ (t << 16);
+    return x;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Slice 64 bytes into 8 bit planes.
+ *
+ * @param in The 64 input bytes.
+ * @param planes Output, bit i of planes[b] is bit b of in[i].
+ */
+static void HAMMING_IRAM_ATTR slice_load(const uint8_t in[BITSLICE_BLOCK], uint64_t planes[8])
+{
+    for (int b = 0; b < 8; b++) {
+        planes[b] = 0;
+    }
+
+#if defined(__SSE2__)
+    // movemask gathers bit 7 of every byte, so shift each byte up one bit at a time
+    for (int q = 0; q < 4; q++) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(in + 16 * q));
+        for (int b = 7; b >= 0; b--) {
+            planes[b] |= (uint64_t)(uint16_t)_mm_movemask_epi8(v) << (16 * q);
+            v = _mm_add_epi8(v, v);
+        }
+    }
+#else
+    for (int k = 0; k < 8; k++) {
+        uint64_t t = hamming_transpose8(hamming_load64_le(in + 8 * k));
+        for (int b = 0; b < 8; b++) {
+            planes[b] |= ((t >> (8 * b)) & 0xFF) << (8 * k);
+        }
+    }
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Inverse of slice_load(), turn 8 bit planes back into 64 bytes.
+ */
+static void HAMMING_IRAM_ATTR slice_store(const uint64_t planes[8], uint8_t out[BITSLICE_BLOCK])
+{
+    for (int k = 0; k < 8; k++) {
+        uint64_t t = 0;
+        for (int b = 0; b < 8; b++) {
+            t |= ((planes[b] >> (8 * k)) & 0xFF) << (8 * b);
+        }
+        hamming_store64_le(out + 8 * k, hamming_transpose8(t));
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Compute the codeword planes for 64 nibbles given their data planes.
+ *
+ * Plane b of the result is bit b of the packed codeword, so plane 6 is P1 and
+ * plane 0 is D4.
+ */
+HAMMING_INLINE void encode_planes(uint64_t d1, uint64_t d2, uint64_t d3, uint64_t d4,
+                                 uint64_t cw[8])
+{
+    cw[7] = 0;
+    cw[6] = d1 ^ d2 ^ d4;  // P1 covers positions 3, 5, 7
+    cw[5] = d1 ^ d3 ^ d4;  // P2 covers positions 3, 6, 7
+    cw[4] = d1;
+    cw[3] = d2 ^ d3 ^ d4;  // P4 covers positions 5, 6, 7
+    cw[2] = d2;
+    cw[1] = d3;
+    cw[0] = d4;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Correct and extract the data planes of 64 codewords.
+ *
+ * @param c Codeword planes as produced by slice_load() (plane 7 is ignored).
+ * @param d Output data planes, d[0] is D1 through d[3] is D4.
+ * @param s Output syndrome planes, s[0] is S1, s[1] is S2 and s[2] is S4.
+ */
+HAMMING_INLINE void decode_planes(const uint64_t c[8], uint64_t d[4], uint64_t s[3])
+{
+    // Position p lives in plane (7 - p)
+    uint64_t s1 = c[6] ^ c[4] ^ c[2] ^ c[0];
+    uint64_t s2 = c[5] ^ c[4] ^ c[1] ^ c[0];
+    uint64_t s4 = c[3] ^ c[2] ^ c[1] ^ c[0];
+
+    // A data bit is flipped when the syndrome equals its position (3, 5, 6, 7)
+    d[0] = c[4] ^ (s1 & s2 & ~s4);
+    d[1] = c[2] ^ (s1 & ~s2 & s4);
+    d[2] = c[1] ^ (~s1 & s2 & s4);
+    d[3] = c[0] ^ (s1 & s2 & s4);
+
+    s[0] = s1;
+    s[1] = s2;
+    s[2] = s4;
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   Codec Kernels    -----------------   */
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming74_bitslice_encode(const uint8_t *data, size_t data_size, uint8_t *codewords)
+{
+    size_t done = 0;
+
+    for (; done + BITSLICE_BLOCK <= data_size; done += BITSLICE_BLOCK) {
+        uint64_t d[8], hi[8], lo[8], out[8];
+        slice_load(data + done, d);
+
+        // Bits 7..4 are the high nibbles, bits 3..0 the low nibbles
+        encode_planes(d[7], d[6], d[5], d[4], hi);
+        encode_planes(d[3], d[2], d[1], d[0], lo);
+
+        // Codeword 2i is the high nibble of byte i, codeword 2i+1 the low nibble
+        for (int b = 0; b < 8; b++) {
+            out[b] = shuffle64((hi[b] & 0xFFFFFFFFULL) | (lo[b] << 32));
+        }
+        slice_store(out, codewords + 2 * done);
+
+        for (int b = 0; b < 8; b++) {
+            out[b] = shuffle64((hi[b] >> 32) | (lo[b] & 0xFFFFFFFF00000000ULL));
+        }
+        slice_store(out, codewords + 2 * done + BITSLICE_BLOCK);
+    }
+
+    hamming74_table_encode(data + done, data_size - done, codewords + 2 * done);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t HAMMING_IRAM_ATTR hamming74_bitslice_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                                   uint8_t *syndromes)
+{
+    size_t corrected = 0;
+    size_t done = 0;
+
+    for (; done + BITSLICE_BLOCK <= data_size; done += BITSLICE_BLOCK) {
+        uint64_t out[8] = {0};
+
+        // Each half of the block holds 64 codewords, i.e. 32 data bytes
+        for (int h = 0; h < 2; h++) {
+            uint64_t c[8], d[4], s[3];
+            slice_load(codewords + 2 * done + h * BITSLICE_BLOCK, c);
+            decode_planes(c, d, s);
+
+            corrected += hamming_popcount64(s[0] | s[1] | s[2]);
+            if (syndromes != NULL) {
+                // The syndrome planes are bits 0..2 of one syndrome byte per codeword
+                uint64_t planes[8] = {s[0], s[1], s[2], 0, 0, 0, 0, 0};
+                slice_store(planes, syndromes + 2 * done + h * BITSLICE_BLOCK);
+            }
+
+            // Even codewords are high nibbles, odd codewords are low nibbles
+            for (int j = 0; j < 4; j++) {
+                uint64_t u = unshuffle64(d[j]);
+                out[7 - j] |= (u & 0xFFFFFFFFULL) << (32 * h);
+                out[3 - j] |= (u >> 32) << (32 * h);
+            }
+        }
+        slice_store(out, data + done);
+    }
+
+    corrected += hamming74_table_decode(codewords + 2 * done, data_size - done, data + done,
+                                        syndromes != NULL ? syndromes + 2 * done : NULL);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+#endif  // HAMMING_HAVE_BITSLICE
@@ -0,0 +1,201 @@
+/**
+ * @file hamming_block.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief ECC-protected page storage using Hamming(8,4) SECDED codewords.
+ *
+ * Reads verify lazily: the syndromes of a page are checked first, a clean
+ * page only has its data bits gathered and the correcting decoder runs for
+ * dirty pages only. On devices with a map callback the codewords are decoded
+ * in place in the mapping, otherwise they are read in small chunks.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_block.h"
+#include "hamming_private.h"
+
+/** Data bytes handled per device read or write when the page is not mapped. */
+#define BLOCK_CHUNK 128
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Decode data_size bytes of codewords, skipping correction if they are clean.
+ */
+static void decode_lazy(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                        hamming_stats_t *stats)
+{
+    if (hamming84_is_clean(codewords, 2 * data_size)) {
+        hamming_extract_bytes(codewords, data_size, data);
+    } else {
+        hamming84_table_decode(codewords, data_size, data, stats);
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+int hamming_block_init(hamming_block_t *block, const hamming_block_dev_t *dev, size_t page_size)
+{
+    if (page_size == 0 || 2 * page_size > dev->size) {
+        return -1;
+    }
+    if (dev->erase != NULL && (dev->erase_size == 0 || (2 * page_size) % dev->erase_size != 0)) {
+        return -1;
+    }
+
+    block->dev = dev;
+    block->page_size = page_size;
+    block->page_count = dev->size / (2 * page_size);
+    block->stats.corrected = 0;
+    block->stats.uncorrectable = 0;
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_block_write(hamming_block_t *block, size_t page, const void *data)
+{
+    const hamming_block_dev_t *dev = block->dev;
+    const uint8_t *src = (const uint8_t *)data;
+    size_t offset = page * 2 * block->page_size;
+
+    if (page >= block->page_count) {
+        return -1;
+    }
+    if (dev->erase != NULL && dev->erase(dev->ctx, offset, 2 * block->page_size) != 0) {
+        return -1;
+    }
+
+    uint8_t codewords[2 * BLOCK_CHUNK];
+    for (size_t done = 0; done < block->page_size; done += BLOCK_CHUNK) {
+        size_t len = block->page_size - done;
+        if (len > BLOCK_CHUNK) {
+            len = BLOCK_CHUNK;
+        }
+        hamming84_table_encode(src + done, len, codewords);
+        if (dev->write(dev->ctx, offset + 2 * done, codewords, 2 * len) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_block_read(hamming_block_t *block, size_t page, void *data, hamming_stats_t *stats)
+{
+    const hamming_block_dev_t *dev = block->dev;
+    uint8_t *dst = (uint8_t *)data;
+    size_t offset = page * 2 * block->page_size;
+    hamming_stats_t local = {0, 0};
+
+    if (page >= block->page_count) {
+        return -1;
+    }
+
+    void *handle = NULL;
+    const uint8_t *mapped = (dev->map != NULL)
+                                ? (const uint8_t *)dev->map(dev->ctx, offset, 2 * block->page_size, &handle)
+                                : NULL;
+
+    if (mapped != NULL) {
+        decode_lazy(mapped, block->page_size, dst, &local);
+        if (dev->unmap != NULL) {
+            dev->unmap(dev->ctx, handle);
+        }
+    } else {
+        uint8_t codewords[2 * BLOCK_CHUNK];
+        for (size_t done = 0; done < block->page_size; done += BLOCK_CHUNK) {
+            size_t len = block->page_size - done;
+            if (len > BLOCK_CHUNK) {
+                len = BLOCK_CHUNK;
+            }
+            if (dev->read(dev->ctx, offset + 2 * done, codewords, 2 * len) != 0) {
+                return -1;
+            }
+            decode_lazy(codewords, len, dst + done, &local);
+        }
+    }
+
+    block->stats.corrected += local.corrected;
+    block->stats.uncorrectable += local.uncorrectable;
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+    return (local.uncorrectable != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------*/
+/*  ---------------   ESP-IDF Partition   ----------------   */
+/*-----------------------------------------------------------*/
+
+#if defined(ESP_PLATFORM)
+
+static int partition_read(void *ctx, size_t offset, void *dst, size_t len)
+{
+    return (esp_partition_read((const esp_partition_t *)ctx, offset, dst, len) == ESP_OK) ? 0 : -1;
+}
+
+/*-----------------------------------------------------------*/
+
+static int partition_write(void *ctx, size_t offset, const void *src, size_t len)
+{
+    return (esp_partition_write((const esp_partition_t *)ctx, offset, src, len) == ESP_OK) ? 0 : -1;
+}
+
+/*-----------------------------------------------------------*/
+
+static int partition_erase(void *ctx, size_t offset, size_t len)
+{
+    return (esp_partition_erase_range((const esp_partition_t *)ctx, offset, len) == ESP_OK) ? 0 : -1;
+}
+
+/*-----------------------------------------------------------*/
+
+static const void *partition_map(void *ctx, size_t offset, size_t len, void **handle)
+{
+    const void *ptr = NULL;
+    esp_partition_mmap_handle_t h;
+
+    if (esp_partition_mmap((const esp_partition_t *)ctx, offset, len, ESP_PARTITION_MMAP_DATA, &ptr, &h) != ESP_OK) {
+        return NULL;  // Falls back to chunked reads
+    }
+    *handle = (void *)(uintptr_t)h;
+    return ptr;
+}
+
+/*-----------------------------------------------------------*/
+
+static void partition_unmap(void *ctx, void *handle)
+{
+    (void)ctx;
+    esp_partition_munmap((esp_partition_mmap_handle_t)(uintptr_t)handle);
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_block_dev_partition(hamming_block_dev_t *dev, const esp_partition_t *partition)
+{
+    dev->ctx = (void *)partition;
+    dev->size = partition->size;
+    dev->erase_size = partition->erase_size;
+    dev->read = partition_read;
+    dev->write = partition_write;
+    dev->erase = partition_erase;
+    dev->map = partition_map;
+    dev->unmap = partition_unmap;
+}
+
+#endif  // ESP_PLATFORM
+
+/*-----------------------------------------------------------*/
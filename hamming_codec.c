@@ -0,0 +1,274 @@
+/**
+ * @file hamming_codec.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Generalized Hamming(2^r-1, 2^r-1-r) codec, optionally shortened and SECDED.
+ *
+ * Codewords use the classic positional layout: position 1, 2, 4, ... hold
+ * the parity bits and the remaining positions hold the data bits in order.
+ * With SECDED an extended parity bit (position 0) precedes them. Instead of
+ * walking bit positions, every parity bit is computed as the parity of the
+ * data word masked with the data bits it covers.
+ *
+ * @note
+ *  Data and codewords are dense MSB-first bit streams, so the (7,4) and (8,4)
+ *  codecs produce the same bits as the byte API.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_private.h"
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief MSB-first bit writer, bytes past limit are dropped.
+ */
+typedef struct {
+    uint8_t *out;
+    size_t pos;
+    size_t limit;
+    uint64_t acc;
+    unsigned bits;
+} bit_writer_t;
+
+/**
+ * @brief MSB-first bit reader, reads past the end return zero bits.
+ */
+typedef struct {
+    const uint8_t *in;
+    size_t pos;
+    size_t size;
+    uint64_t acc;
+    unsigned bits;
+} bit_reader_t;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Append the low count bits (at most 32) of value.
+ */
+static inline void bw_put(bit_writer_t *w, uint64_t value, unsigned count)
+{
+    w->acc = (w->acc << count) | (value & ((1ULL << count) - 1));
+    w->bits += count;
+    while (w->bits >= 8) {
+        w->bits -= 8;
+        if (w->pos < w->limit) {
+            w->out[w->pos] = (uint8_t)(w->acc >> w->bits);
+        }
+        w->pos++;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write out a partial last byte, zero padded.
+ */
+static inline void bw_flush(bit_writer_t *w)
+{
+    if (w->bits != 0) {
+        bw_put(w, 0, 8 - w->bits);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read the next count bits (at most 32).
+ */
+static inline uint64_t br_get(bit_reader_t *r, unsigned count)
+{
+    while (r->bits < count) {
+        r->acc = (r->acc << 8) | (r->pos < r->size ? r->in[r->pos] : 0);
+        r->pos++;
+        r->bits += 8;
+    }
+    r->bits -= count;
+    return (r->acc >> r->bits) & ((1ULL << count) - 1);
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Number of data positions between parity bits 2^i and 2^(i+1).
+ */
+static inline unsigned run_length(const hamming_codec_t *codec, unsigned i)
+{
+    unsigned last = (unsigned)codec->k + codec->r;  // Highest used position
+    unsigned hi = (2u << i) - 1;
+    if (hi > last) {
+        hi = last;
+    }
+    return hi - (1u << i);
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Number of codewords needed for data_size bytes.
+ */
+static inline size_t codeword_count(const hamming_codec_t *codec, size_t data_size)
+{
+    return (data_size * 8 + codec->k - 1) / codec->k;
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+int hamming_codec_init(hamming_codec_t *codec, unsigned n, unsigned k)
+{
+    if (k == 0 || k > 64) {
+        return -1;
+    }
+
+    // Smallest r such that 2^r >= k + r + 1
+    unsigned r = 2;
+    while ((1u << r) < k + r + 1) {
+        r++;
+    }
+    if (n != k + r && n != k + r + 1) {
+        return -1;
+    }
+
+    codec->n = (uint8_t)n;
+    codec->k = (uint8_t)k;
+    codec->r = (uint8_t)r;
+    codec->secded = (uint8_t)(n == k + r + 1);
+
+    // Data bit j (bit k-1-j of the data word) sits at the j-th non-power-of-two position
+    for (unsigned i = 0; i < HAMMING_CODEC_MAX_R; i++) {
+        codec->data_mask[i] = 0;
+    }
+    unsigned j = 0;
+    for (unsigned pos = 3; j < k; pos++) {
+        if ((pos & (pos - 1)) == 0) {
+            continue;
+        }
+        for (unsigned i = 0; i < r; i++) {
+            if (pos & (1u << i)) {
+                codec->data_mask[i] |= 1ULL << (k - 1 - j);
+            }
+        }
+        j++;
+    }
+
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_codec_encoded_size(const hamming_codec_t *codec, size_t data_size)
+{
+    return (codeword_count(codec, data_size) * codec->n + 7) / 8;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_codec_encode(const hamming_codec_t *codec, const void *data, size_t data_size,
+                            uint8_t *out)
+{
+    const unsigned k = codec->k;
+    bit_reader_t in = {(const uint8_t *)data, 0, data_size, 0, 0};
+    bit_writer_t w = {out, 0, SIZE_MAX, 0, 0};
+    size_t count = codeword_count(codec, data_size);
+
+    for (size_t c = 0; c < count; c++) {
+        // First data bit ends up in bit k-1
+        uint64_t v = (k > 32) ? (br_get(&in, k - 32) << 32) | br_get(&in, 32) : br_get(&in, k);
+
+        unsigned check = 0;
+        for (unsigned i = 0; i < codec->r; i++) {
+            check |= (unsigned)hamming_parity64(v & codec->data_mask[i]) << i;
+        }
+        if (codec->secded) {
+            bw_put(&w, hamming_parity64(v) ^ hamming_parity64(check), 1);
+        }
+
+        // Parity bit 2^i, followed by the data positions up to the next power of two
+        unsigned used = 0;
+        for (unsigned i = 0; i < codec->r; i++) {
+            bw_put(&w, check >> i, 1);
+            unsigned len = run_length(codec, i);
+            if (len != 0) {
+                used += len;
+                bw_put(&w, v >> (k - used), len);
+            }
+        }
+    }
+
+    bw_flush(&w);
+    return w.pos;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_codec_decode(const hamming_codec_t *codec, const uint8_t *in, size_t data_size,
+                         void *data, hamming_stats_t *stats)
+{
+    const unsigned k = codec->k;
+    const unsigned last = k + codec->r;
+    bit_reader_t r = {in, 0, hamming_codec_encoded_size(codec, data_size), 0, 0};
+    bit_writer_t w = {(uint8_t *)data, 0, data_size, 0, 0};
+    size_t count = codeword_count(codec, data_size);
+    hamming_stats_t local = {0, 0};
+
+    for (size_t c = 0; c < count; c++) {
+        unsigned ext = codec->secded ? (unsigned)br_get(&r, 1) : 0;
+        unsigned check = 0;
+        uint64_t v = 0;
+        for (unsigned i = 0; i < codec->r; i++) {
+            check |= (unsigned)br_get(&r, 1) << i;
+            unsigned len = run_length(codec, i);
+            if (len != 0) {
+                v = (v << len) | br_get(&r, len);
+            }
+        }
+
+        unsigned syndrome = 0;
+        for (unsigned i = 0; i < codec->r; i++) {
+            syndrome |= (unsigned)(hamming_parity64(v & codec->data_mask[i]) ^ ((check >> i) & 1)) << i;
+        }
+        unsigned overall = codec->secded ? (hamming_parity64(v) ^ hamming_parity64(check) ^ ext) : (syndrome != 0);
+
+        if (syndrome == 0 && overall == 0) {
+            // Clean codeword
+        } else if (overall == 0 || syndrome > last) {
+            // Double error (SECDED) or a syndrome beyond the shortened codeword
+            local.uncorrectable++;
+        } else {
+            // Single error, only data positions need fixing
+            if (syndrome != 0 && (syndrome & (syndrome - 1)) != 0) {
+                unsigned log2 = 0;
+                while ((2u << log2) <= syndrome) {
+                    log2++;
+                }
+                unsigned j = syndrome - log2 - 2;  // Data index of this position
+                v ^= 1ULL << (k - 1 - j);
+            }
+            local.corrected++;
+        }
+
+        if (k > 32) {
+            bw_put(&w, v >> 32, k - 32);
+            bw_put(&w, v, 32);
+        } else {
+            bw_put(&w, v, k);
+        }
+    }
+
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+    return (local.uncorrectable != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------*/
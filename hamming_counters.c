@@ -0,0 +1,211 @@
+/**
+ * @file hamming_counters.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Optional counters behind the encode and decode entry points.
+ *
+ * Every core owns a slot of relaxed atomic counters, so cores never contend
+ * on a cache line and a task preempted mid-update cannot lose a count.
+ * On the host, threads are spread over HAMMING_COUNTER_SLOTS slots the
+ * first time they record. Snapshots sum the slots.
+ *
+ * Built with CONFIG_HAMMING_COUNTERS, otherwise only the snapshot and reset
+ * stubs remain and the entry points are not instrumented.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#if !defined(ESP_PLATFORM) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "hamming_private.h"
+
+#if HAMMING_HAVE_COUNTERS
+
+#if defined(ESP_PLATFORM)
+#include "esp_idf_version.h"
+#include "freertos/FreeRTOS.h"
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include "esp_cpu.h"
+#else
+#include "hal/cpu_hal.h"
+#endif
+#define HAMMING_COUNTER_SLOTS portNUM_PROCESSORS
+#else
+#include <time.h>
+#define HAMMING_COUNTER_SLOTS 16
+#endif
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Counter Slots   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Counters of one core, padded to its own cache line.
+ */
+typedef struct {
+    _Alignas(64) _Atomic uint64_t encoded;
+    _Atomic uint64_t decoded;
+    _Atomic uint64_t corrected;
+    _Atomic uint64_t uncorrectable;
+    _Atomic uint64_t encode_time;
+    _Atomic uint64_t decode_time;
+} counter_slot_t;
+
+static counter_slot_t slots[HAMMING_COUNTER_SLOTS];
+
+#if !defined(ESP_PLATFORM)
+/** Slot handed to the next thread that records. */
+static _Atomic unsigned next_slot;
+#endif
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Slot of the calling core, or of the calling thread on the host.
+ */
+static counter_slot_t *HAMMING_IRAM_ATTR own_slot(void)
+{
+#if defined(ESP_PLATFORM)
+    return &slots[xPortGetCoreID()];
+#else
+    static _Thread_local counter_slot_t *slot;
+    if (slot == NULL) {
+        slot = &slots[atomic_fetch_add_explicit(&next_slot, 1, memory_order_relaxed) % HAMMING_COUNTER_SLOTS];
+    }
+    return slot;
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+#if defined(CONFIG_HAMMING_COUNTERS_TIMING)
+/**
+ * @brief Time since start.
+ */
+static uint64_t HAMMING_IRAM_ATTR elapsed(uint64_t start)
+{
+#if defined(ESP_PLATFORM)
+    // The cycle counter is 32 bits wide, wrap the difference accordingly
+    return (uint32_t)(hamming_counters_now() - start);
+#else
+    return hamming_counters_now() - start;
+#endif
+}
+#endif
+
+/*-----------------------------------------------------------*/
+
+HAMMING_INLINE void add(_Atomic uint64_t *counter, uint64_t value)
+{
+    atomic_fetch_add_explicit(counter, value, memory_order_relaxed);
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+uint64_t HAMMING_IRAM_ATTR hamming_counters_now(void)
+{
+#if defined(ESP_PLATFORM)
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    return (uint32_t)esp_cpu_get_cycle_count();
+#else
+    return (uint32_t)cpu_hal_get_cycle_count();
+#endif
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming_counters_add_encode(size_t codewords, uint64_t start)
+{
+    counter_slot_t *slot = own_slot();
+    add(&slot->encoded, codewords);
+#if defined(CONFIG_HAMMING_COUNTERS_TIMING)
+    add(&slot->encode_time, elapsed(start));
+#else
+    (void)start;
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+void HAMMING_IRAM_ATTR hamming_counters_add_decode(size_t codewords, size_t corrected, size_t uncorrectable,
+                                                   uint64_t start)
+{
+    counter_slot_t *slot = own_slot();
+    add(&slot->decoded, codewords);
+    if (corrected != 0) {
+        add(&slot->corrected, corrected);
+    }
+    if (uncorrectable != 0) {
+        add(&slot->uncorrectable, uncorrectable);
+    }
+#if defined(CONFIG_HAMMING_COUNTERS_TIMING)
+    add(&slot->decode_time, elapsed(start));
+#else
+    (void)start;
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_counters_snapshot(hamming_counters_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    for (int i = 0; i < HAMMING_COUNTER_SLOTS; i++) {
+        out->encoded += atomic_load_explicit(&slots[i].encoded, memory_order_relaxed);
+        out->decoded += atomic_load_explicit(&slots[i].decoded, memory_order_relaxed);
+        out->corrected += atomic_load_explicit(&slots[i].corrected, memory_order_relaxed);
+        out->uncorrectable += atomic_load_explicit(&slots[i].uncorrectable, memory_order_relaxed);
+        out->encode_time += atomic_load_explicit(&slots[i].encode_time, memory_order_relaxed);
+        out->decode_time += atomic_load_explicit(&slots[i].decode_time, memory_order_relaxed);
+    }
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_counters_reset(void)
+{
+    for (int i = 0; i < HAMMING_COUNTER_SLOTS; i++) {
+        atomic_store_explicit(&slots[i].encoded, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].decoded, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].corrected, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].uncorrectable, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].encode_time, 0, memory_order_relaxed);
+        atomic_store_explicit(&slots[i].decode_time, 0, memory_order_relaxed);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#else  // !HAMMING_HAVE_COUNTERS
+
+int hamming_counters_snapshot(hamming_counters_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    return -1;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_counters_reset(void)
+{
+}
+
+#endif  // HAMMING_HAVE_COUNTERS
@@ -0,0 +1,178 @@
+/**
+ * @file hamming_dispatch.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Runtime selection of the codec engine behind the byte API.
+ *
+ * The best engine is resolved once, on first use: cpuid on x86, HWCAP on
+ * AArch64 Linux and CONFIG_HAMMING_DEFAULT_ENGINE on ESP-IDF. It can be
+ * overridden with hamming74_set_engine().
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <stdatomic.h>
+
+#include "hamming_private.h"
+
+#if HAMMING_HAVE_NEON && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_ASIMD
+#define HWCAP_ASIMD (1 << 1)
+#endif
+#endif
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Engine Table   -------------------   */
+/*-----------------------------------------------------------*/
+
+/** Indexed by hamming74_engine_t, entries without kernels are NULL. */
+HAMMING_DRAM_ATTR static const hamming74_engine_ops_t engine_table[HAMMING74_ENGINE_COUNT] = {
+#if HAMMING_HAVE_SCALAR
+    [HAMMING74_ENGINE_SCALAR] = {HAMMING74_ENGINE_SCALAR, "scalar", hamming74_scalar_encode, hamming74_scalar_decode, hamming74_scalar_is_clean},
+#endif
+    [HAMMING74_ENGINE_TABLE] = {HAMMING74_ENGINE_TABLE, "table", hamming74_table_encode, hamming74_table_decode, hamming74_swar_is_clean},
+#if HAMMING_HAVE_BITSLICE
+    [HAMMING74_ENGINE_BITSLICE] = {HAMMING74_ENGINE_BITSLICE, "bitslice", hamming74_bitslice_encode, hamming74_bitslice_decode, hamming74_swar_is_clean},
+#endif
+#if HAMMING_HAVE_X86_SIMD
+    [HAMMING74_ENGINE_SSSE3] = {HAMMING74_ENGINE_SSSE3, "ssse3", hamming74_ssse3_encode, hamming74_ssse3_decode, hamming74_ssse3_is_clean},
+    [HAMMING74_ENGINE_AVX2] = {HAMMING74_ENGINE_AVX2, "avx2", hamming74_avx2_encode, hamming74_avx2_decode, hamming74_avx2_is_clean},
+#endif
+    [HAMMING74_ENGINE_CONSTTIME] = {HAMMING74_ENGINE_CONSTTIME, "consttime", hamming74_table_encode, hamming74_consttime_decode, hamming74_swar_is_clean},
+#if HAMMING_HAVE_NEON
+    [HAMMING74_ENGINE_NEON] = {HAMMING74_ENGINE_NEON, "neon", hamming74_neon_encode, hamming74_neon_decode, hamming74_neon_is_clean},
+#endif
+};
+
+/** Engine used by the byte API, NULL until resolved. */
+static _Atomic(const hamming74_engine_ops_t *) active_engine;
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check whether the CPU supports the instructions an engine needs.
+ */
+static int cpu_supports(hamming74_engine_t engine)
+{
+    switch (engine) {
+#if HAMMING_HAVE_X86_SIMD
+    case HAMMING74_ENGINE_SSSE3:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3");
+    case HAMMING74_ENGINE_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2");
+#endif
+#if HAMMING_HAVE_NEON
+    case HAMMING74_ENGINE_NEON:
+#if defined(__linux__)
+        return (getauxval(AT_HWCAP) & HWCAP_ASIMD) != 0;
+#else
+        return 1;  // Advanced SIMD is mandatory on AArch64
+#endif
+#endif
+    default:
+        return 1;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Pick the fastest engine for this host.
+ */
+static const hamming74_engine_ops_t *HAMMING_IRAM_ATTR resolve_auto(void)
+{
+#if defined(ESP_PLATFORM)
+#if defined(CONFIG_HAMMING_DEFAULT_ENGINE_BITSLICE) && HAMMING_HAVE_BITSLICE
+    return &engine_table[HAMMING74_ENGINE_BITSLICE];
+#elif defined(CONFIG_HAMMING_DEFAULT_ENGINE_CONSTTIME)
+    return &engine_table[HAMMING74_ENGINE_CONSTTIME];
+#elif defined(CONFIG_HAMMING_DEFAULT_ENGINE_SCALAR) && HAMMING_HAVE_SCALAR
+    return &engine_table[HAMMING74_ENGINE_SCALAR];
+#else
+    // No SIMD shuffles on Xtensa / RISC-V, the table engine is the fastest
+    return &engine_table[HAMMING74_ENGINE_TABLE];
+#endif
+#else
+    static const hamming74_engine_t preferred[] = {
+        HAMMING74_ENGINE_AVX2,
+        HAMMING74_ENGINE_SSSE3,
+        HAMMING74_ENGINE_NEON,
+    };
+    for (size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); i++) {
+        if (hamming74_engine_available(preferred[i])) {
+            return &engine_table[preferred[i]];
+        }
+    }
+    return &engine_table[HAMMING74_ENGINE_TABLE];
+#endif
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+const hamming74_engine_ops_t *HAMMING_IRAM_ATTR hamming74_engine_ops(void)
+{
+    const hamming74_engine_ops_t *ops = atomic_load_explicit(&active_engine, memory_order_acquire);
+    if (ops == NULL) {
+        // Racing first calls all resolve to the same engine, so a plain store is enough
+        ops = resolve_auto();
+        atomic_store_explicit(&active_engine, ops, memory_order_release);
+    }
+    return ops;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming74_engine_available(hamming74_engine_t engine)
+{
+    if (engine == HAMMING74_ENGINE_AUTO) {
+        return 1;
+    }
+    if ((unsigned)engine >= HAMMING74_ENGINE_COUNT || engine_table[engine].encode == NULL) {
+        return 0;
+    }
+    return cpu_supports(engine);
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming74_set_engine(hamming74_engine_t engine)
+{
+    if (!hamming74_engine_available(engine)) {
+        return -1;
+    }
+    const hamming74_engine_ops_t *ops = (engine == HAMMING74_ENGINE_AUTO) ? resolve_auto() : &engine_table[engine];
+    atomic_store_explicit(&active_engine, ops, memory_order_release);
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+hamming74_engine_t hamming74_get_engine(void)
+{
+    return hamming74_engine_ops()->id;
+}
+
+/*-----------------------------------------------------------*/
+
+const char *hamming74_engine_name(hamming74_engine_t engine)
+{
+    if (engine == HAMMING74_ENGINE_AUTO) {
+        return "auto";
+    }
+    if ((unsigned)engine >= HAMMING74_ENGINE_COUNT || engine_table[engine].name == NULL) {
+        return "unknown";
+    }
+    return engine_table[engine].name;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,158 @@
+/**
+ * @file hamming_frame.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Frame codec with the CRC fused into the encode and decode loops.
+ *
+ * The payload is processed in chunks of FRAME_CHUNK bytes. Each chunk is
+ * run through the CRC and then encoded, or decoded and then run through the
+ * CRC, so the second pass reads the bytes from L1 instead of memory.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <string.h>
+
+#include "hamming_frame.h"
+#include "hamming_private.h"
+
+/** Payload bytes per chunk, the chunk and its codewords stay in L1. */
+#define FRAME_CHUNK 512
+
+/** Largest CRC in bytes. */
+#define FRAME_CRC_MAX 4
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+static size_t crc_size(hamming_crc_t crc)
+{
+    return (crc == HAMMING_CRC32) ? 4 : 2;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t crc_init(hamming_crc_t crc)
+{
+    return (crc == HAMMING_CRC32) ? 0 : HAMMING_CRC16_INIT;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t crc_update(hamming_crc_t crc, uint32_t state, const uint8_t *data, size_t size)
+{
+    if (crc == HAMMING_CRC32) {
+        return hamming_crc32(state, data, size);
+    }
+    return hamming_crc16((uint16_t)state, data, size);
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Serialize a CRC as it is stored in the frame.
+ *
+ * CRC-32 is reflected and stored little-endian, CRC-16/CCITT-FALSE is MSB
+ * first and stored big-endian.
+ */
+static void crc_store(hamming_crc_t crc, uint32_t state, uint8_t out[FRAME_CRC_MAX])
+{
+    if (crc == HAMMING_CRC32) {
+        for (int i = 0; i < 4; i++) {
+            out[i] = (uint8_t)(state >> (8 * i));
+        }
+    } else {
+        out[0] = (uint8_t)(state >> 8);
+        out[1] = (uint8_t)state;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void encode_chunk(hamming_frame_code_t code, const uint8_t *data, size_t size, uint8_t *codewords)
+{
+    if (code == HAMMING_FRAME_84) {
+        hamming84_encode_bytes(data, size, codewords);
+    } else {
+        hamming74_encode_bytes(data, size, codewords);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void decode_chunk(hamming_frame_code_t code, const uint8_t *codewords, size_t size, uint8_t *data,
+                         hamming_stats_t *stats)
+{
+    if (code == HAMMING_FRAME_84) {
+        (void)hamming84_decode_bytes(codewords, size, data, stats);
+    } else {
+        stats->corrected += hamming74_decode_bytes(codewords, size, data);
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+size_t hamming_frame_encoded_size(size_t payload_size, hamming_crc_t crc)
+{
+    return 2 * (payload_size + crc_size(crc));
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_frame_encode(const uint8_t *payload, size_t payload_size, uint8_t *codewords,
+                            hamming_frame_code_t code, hamming_crc_t crc)
+{
+    uint32_t state = crc_init(crc);
+
+    for (size_t off = 0; off < payload_size; off += FRAME_CHUNK) {
+        size_t n = (payload_size - off < FRAME_CHUNK) ? payload_size - off : FRAME_CHUNK;
+        state = crc_update(crc, state, payload + off, n);
+        encode_chunk(code, payload + off, n, codewords + 2 * off);
+    }
+
+    uint8_t tail[FRAME_CRC_MAX];
+    crc_store(crc, state, tail);
+    encode_chunk(code, tail, crc_size(crc), codewords + 2 * payload_size);
+
+    return hamming_frame_encoded_size(payload_size, crc);
+}
+
+/*-----------------------------------------------------------*/
+
+hamming_frame_status_t hamming_frame_decode(const uint8_t *codewords, size_t payload_size, uint8_t *payload,
+                                            hamming_frame_code_t code, hamming_crc_t crc,
+                                            hamming_stats_t *stats)
+{
+    hamming_stats_t local = {0, 0};
+    uint32_t state = crc_init(crc);
+
+    for (size_t off = 0; off < payload_size; off += FRAME_CHUNK) {
+        size_t n = (payload_size - off < FRAME_CHUNK) ? payload_size - off : FRAME_CHUNK;
+        decode_chunk(code, codewords + 2 * off, n, payload + off, &local);
+        state = crc_update(crc, state, payload + off, n);
+    }
+
+    uint8_t received[FRAME_CRC_MAX];
+    uint8_t expected[FRAME_CRC_MAX];
+    decode_chunk(code, codewords + 2 * payload_size, crc_size(crc), received, &local);
+    crc_store(crc, state, expected);
+
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+
+    if (local.uncorrectable != 0) {
+        return HAMMING_FRAME_UNCORRECTABLE;
+    }
+    if (memcmp(received, expected, crc_size(crc)) != 0) {
+        return HAMMING_FRAME_CRC_FAIL;
+    }
+    return (local.corrected != 0) ? HAMMING_FRAME_CORRECTED : HAMMING_FRAME_CLEAN;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file hamming_iov.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Scatter-gather encoding and decoding on top of the streaming API.
+ *
+ * Input segments are fed to a hamming74_stream_t, which carries half bytes
+ * and partial packed codewords across them. Each input segment is cut at the
+ * points where its output stops fitting the current output segment, so
+ * almost all bytes are written in place by the stream's bulk kernels. Only
+ * the at most 2 bytes that straddle two output segments go through a bounce
+ * buffer.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_iov.h"
+#include "hamming_private.h"
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write position in a list of output segments.
+ */
+typedef struct {
+    const hamming_iovec_t *iov;
+    size_t count;
+    size_t index;   // Current segment
+    size_t offset;  // Bytes already written to it
+} iov_cursor_t;
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Contiguous room at the cursor, skipping full and empty segments.
+ *
+ * @return The number of bytes that can be written at *dst, 0 at the end of the list.
+ */
+static size_t cursor_room(iov_cursor_t *c, uint8_t **dst)
+{
+    while (c->index < c->count && c->offset == c->iov[c->index].len) {
+        c->index++;
+        c->offset = 0;
+    }
+    if (c->index == c->count) {
+        return 0;
+    }
+    *dst = (uint8_t *)c->iov[c->index].base + c->offset;
+    return c->iov[c->index].len - c->offset;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Copy a few bytes to the cursor, across segment boundaries.
+ */
+static void cursor_scatter(iov_cursor_t *c, const uint8_t *src, size_t n)
+{
+    while (n > 0) {
+        uint8_t *dst;
+        size_t room = cursor_room(c, &dst);
+        size_t k = (n < room) ? n : room;
+        for (size_t i = 0; i < k; i++) {
+            dst[i] = src[i];
+        }
+        c->offset += k;
+        src += k;
+        n -= k;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Largest prefix of len input bytes whose output fits in room bytes.
+ */
+static size_t fitting_input(const hamming74_stream_t *s, size_t len, size_t room)
+{
+    if (hamming74_stream_output_size(s, len) <= room) {
+        return len;
+    }
+
+    // The output size grows monotonically with the input, bisect on it
+    size_t lo = 0;
+    size_t hi = len;
+    while (lo + 1 < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (hamming74_stream_output_size(s, mid) <= room) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Feed up to limit bytes of the input segments through the stream.
+ *
+ * The caller has checked that the output segments hold everything that is
+ * produced.
+ */
+static void run_stream(hamming74_stream_t *s, const hamming_iovec_t *in, size_t in_count, size_t limit,
+                       iov_cursor_t *out)
+{
+    for (size_t i = 0; i < in_count && limit > 0; i++) {
+        const uint8_t *src = (const uint8_t *)in[i].base;
+        size_t len = (in[i].len < limit) ? in[i].len : limit;
+        limit -= len;
+
+        while (len > 0) {
+            uint8_t *dst = NULL;
+            size_t room = cursor_room(out, &dst);
+            size_t take = fitting_input(s, len, room);
+
+            if (take > 0) {
+                out->offset += hamming74_stream_update(s, src, take, dst);
+            } else {
+                // One input byte yields at most 2 output bytes, split them over the boundary
+                uint8_t bounce[2];
+                take = 1;
+                cursor_scatter(out, bounce, hamming74_stream_update(s, src, take, bounce));
+            }
+            src += take;
+            len -= take;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+size_t hamming_iov_size(const hamming_iovec_t *iov, size_t count)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        total += iov[i].len;
+    }
+    return total;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming74_encode_iov(const hamming_iovec_t *in, size_t in_count, const hamming_iovec_t *out,
+                         size_t out_count, hamming74_format_t format)
+{
+    size_t data_size = hamming_iov_size(in, in_count);
+    size_t needed = (format == HAMMING74_FORMAT_PACKED) ? hamming74_packed_size(data_size)
+                                                         : hamming74_encoded_size(data_size);
+    if (hamming_iov_size(out, out_count) < needed) {
+        return -1;
+    }
+
+    hamming74_stream_t s;
+    hamming74_stream_init(&s, HAMMING74_STREAM_ENCODE, format);
+    iov_cursor_t cursor = {out, out_count, 0, 0};
+    run_stream(&s, in, in_count, data_size, &cursor);
+
+    // The zero-padded last byte of a packed stream
+    uint8_t last;
+    cursor_scatter(&cursor, &last, hamming74_stream_final(&s, &last));
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming74_decode_iov(const hamming_iovec_t *in, size_t in_count, const hamming_iovec_t *out,
+                         size_t out_count, hamming74_format_t format, hamming_stats_t *stats)
+{
+    size_t data_size = hamming_iov_size(out, out_count);
+    size_t needed = (format == HAMMING74_FORMAT_PACKED) ? hamming74_packed_size(data_size)
+                                                         : hamming74_encoded_size(data_size);
+    if (hamming_iov_size(in, in_count) < needed) {
+        return -1;
+    }
+
+    // Exactly the codewords of data_size bytes, the padding bits yield no output
+    hamming74_stream_t s;
+    hamming74_stream_init(&s, HAMMING74_STREAM_DECODE, format);
+    iov_cursor_t cursor = {out, out_count, 0, 0};
+    run_stream(&s, in, in_count, needed, &cursor);
+
+    if (stats != NULL) {
+        stats->corrected += s.corrected;
+    }
+    return 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file hamming_pack.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Dense 7-bit codeword packing for the Hamming(7,4) byte API.
+ *
+ * The packed format is the codeword sequence of hamming_encode_generic()
+ * (high nibble first) written as consecutive 7-bit fields, MSB first, with
+ * the last byte zero padded. Eight codewords fill exactly seven bytes, so
+ * the kernels move one 56-bit word per block with shifts and ors. The same
+ * format is produced by hamming_codec_t (7,4) and HAMMING74_FORMAT_PACKED.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_private.h"
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Both codewords of a data byte as one 14-bit field, high nibble first.
+ */
+static inline uint64_t encode_pair(uint8_t byte)
+{
+    return ((uint64_t)hamming74_encode_table[byte >> 4] << 7) | hamming74_encode_table[byte & 0x0F];
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Write count 7-bit fields from bits into a zero-padded tail, count < 8.
+ */
+static size_t pack_tail(uint64_t bits, size_t count, uint8_t *packed)
+{
+    size_t size = (count * 7 + 7) / 8;
+
+    // Left-align the fields in the 56-bit block, the padding stays zero
+    bits <<= 56 - 7 * count;
+    for (size_t i = 0; i < size; i++) {
+        packed[i] = (uint8_t)(bits >> (48 - 8 * i));
+    }
+    return size;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Read a partial block of (count * 7 + 7) / 8 bytes as a left-aligned 56-bit word.
+ */
+static uint64_t unpack_tail(const uint8_t *packed, size_t count)
+{
+    size_t size = (count * 7 + 7) / 8;
+    uint64_t bits = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        bits |= (uint64_t)packed[i] << (48 - 8 * i);
+    }
+    return bits;
+}
+
+/**
+ * @brief Decode the first count data bytes (at most 4) of a left-aligned 56-bit block.
+ */
+static inline size_t decode_block(uint64_t bits, size_t count, uint8_t *data)
+{
+    size_t corrected = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t hi = hamming74_decode_table[(bits >> (49 - 14 * i)) & 0x7F];
+        uint8_t lo = hamming74_decode_table[(bits >> (42 - 14 * i)) & 0x7F];
+        data[i] = (uint8_t)((hi << 4) | (lo & 0x0F));
+        corrected += ((hi >> 4) != 0) + ((lo >> 4) != 0);
+    }
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+size_t hamming74_packed_size(size_t data_size)
+{
+    return (data_size * 14 + 7) / 8;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_pack(const uint8_t *codewords, size_t count, uint8_t *packed)
+{
+    size_t blocks = count / 8;
+
+    for (size_t b = 0; b < blocks; b++) {
+        const uint8_t *c = codewords + 8 * b;
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; i++) {
+            bits = (bits << 7) | (c[i] & 0x7F);
+        }
+        hamming_store56_be(packed + 7 * b, bits);
+    }
+
+    size_t rest = count % 8;
+    if (rest == 0) {
+        return 7 * blocks;
+    }
+
+    uint64_t bits = 0;
+    for (size_t i = 0; i < rest; i++) {
+        bits = (bits << 7) | (codewords[8 * blocks + i] & 0x7F);
+    }
+    return 7 * blocks + pack_tail(bits, rest, packed + 7 * blocks);
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming74_unpack(const uint8_t *packed, size_t count, uint8_t *codewords)
+{
+    size_t blocks = count / 8;
+
+    for (size_t b = 0; b < blocks; b++) {
+        uint64_t bits = hamming_load56_be(packed + 7 * b);
+        uint8_t *c = codewords + 8 * b;
+        for (int i = 0; i < 8; i++) {
+            c[i] = (uint8_t)((bits >> (49 - 7 * i)) & 0x7F);
+        }
+    }
+
+    size_t rest = count % 8;
+    if (rest != 0) {
+        uint64_t bits = unpack_tail(packed + 7 * blocks, rest);
+        for (size_t i = 0; i < rest; i++) {
+            codewords[8 * blocks + i] = (uint8_t)((bits >> (49 - 7 * i)) & 0x7F);
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_encode_packed(const uint8_t *data, size_t data_size, uint8_t *packed)
+{
+    size_t blocks = data_size / 4;
+
+    // 4 data bytes -> 8 codewords -> 7 packed bytes
+    for (size_t b = 0; b < blocks; b++) {
+        const uint8_t *d = data + 4 * b;
+        uint64_t bits = (encode_pair(d[0]) << 42) | (encode_pair(d[1]) << 28) |
+                        (encode_pair(d[2]) << 14) | encode_pair(d[3]);
+        hamming_store56_be(packed + 7 * b, bits);
+    }
+
+    size_t rest = data_size % 4;
+    if (rest == 0) {
+        return 7 * blocks;
+    }
+
+    uint64_t bits = 0;
+    for (size_t i = 0; i < rest; i++) {
+        bits = (bits << 14) | encode_pair(data[4 * blocks + i]);
+    }
+    return 7 * blocks + pack_tail(bits, 2 * rest, packed + 7 * blocks);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_decode_packed(const uint8_t *packed, size_t data_size, uint8_t *data)
+{
+    size_t blocks = data_size / 4;
+    size_t corrected = 0;
+
+    for (size_t b = 0; b < blocks; b++) {
+        uint64_t bits = hamming_load56_be(packed + 7 * b);
+        corrected += decode_block(bits, 4, data + 4 * b);
+    }
+
+    size_t rest = data_size % 4;
+    if (rest != 0) {
+        uint64_t bits = unpack_tail(packed + 7 * blocks, 2 * rest);
+        corrected += decode_block(bits, rest, data + 4 * blocks);
+    }
+
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_decode_packed_inplace(uint8_t *buf, size_t data_size)
+{
+    // Each 7-byte block is loaded before its 4 data bytes are stored at or below it
+    return hamming74_decode_packed(buf, data_size, buf);
+}
+
+/*-----------------------------------------------------------*/
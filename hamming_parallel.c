@@ -0,0 +1,308 @@
+/**
+ * @file hamming_parallel.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Multithreaded byte API for large buffers.
+ *
+ * The buffer is cut into chunks of HAMMING_PARALLEL_CHUNK data bytes that
+ * worker threads claim from a shared atomic cursor, so a slow core never
+ * holds up the rest. The calling thread works as well, and every worker keeps
+ * its own statistics that are summed after the join. Codewords never span a
+ * chunk boundary, so the output is identical to the single-threaded API.
+ *
+ * Threads come from pthreads on POSIX hosts and from a FreeRTOS task pinned to
+ * the other core on ESP-IDF. Elsewhere, or if a thread cannot be started, the
+ * remaining chunks are processed by the caller.
+ *
+ * The workers are started for each call and joined before it returns, there
+ * is no persistent pool. Starting and joining a thread costs about 12 us on a
+ * Linux host, little next to the megabytes worth splitting up, and the
+ * library keeps no threads alive between calls.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include <stdatomic.h>
+
+#include "hamming_private.h"
+
+#if defined(ESP_PLATFORM)
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#define HAMMING_PARALLEL_FREERTOS 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#include <unistd.h>
+#define HAMMING_PARALLEL_PTHREADS 1
+#endif
+
+/** Data bytes per chunk, 32 KiB in and up to 64 KiB out stay within L2. */
+#ifndef HAMMING_PARALLEL_CHUNK
+#define HAMMING_PARALLEL_CHUNK (32u * 1024u)
+#endif
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Job Description   ------------------   */
+/*-----------------------------------------------------------*/
+
+typedef enum {
+    JOB_ENCODE_74,
+    JOB_DECODE_74,
+    JOB_ENCODE_84,
+    JOB_DECODE_84,
+} job_kind_t;
+
+/**
+ * @brief One parallel call, shared by all workers.
+ *
+ * Each worker only writes its own entry of stats.
+ */
+typedef struct {
+    job_kind_t kind;
+    const uint8_t *in;
+    uint8_t *out;
+    size_t data_size;
+    _Atomic size_t next;  // First data byte of the next unclaimed chunk
+    hamming_stats_t stats[HAMMING_PARALLEL_MAX_THREADS];
+} job_t;
+
+/**
+ * @brief Start argument of a worker thread.
+ */
+typedef struct {
+    void (*work)(void *ctx, unsigned worker);
+    void *ctx;
+    unsigned index;
+#if HAMMING_PARALLEL_FREERTOS
+    SemaphoreHandle_t done;  // Given once per worker, local to the call
+#endif
+} worker_t;
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Process data bytes [begin, begin + len) of a job.
+ */
+static void run_chunk(const job_t *job, size_t begin, size_t len, hamming_stats_t *stats)
+{
+    switch (job->kind) {
+    case JOB_ENCODE_74:
+        hamming74_encode_bytes(job->in + begin, len, job->out + 2 * begin);
+        break;
+    case JOB_DECODE_74:
+        stats->corrected += hamming74_decode_bytes(job->in + 2 * begin, len, job->out + begin);
+        break;
+    case JOB_ENCODE_84:
+        hamming84_encode_bytes(job->in + begin, len, job->out + 2 * begin);
+        break;
+    case JOB_DECODE_84:
+        hamming84_decode_bytes(job->in + 2 * begin, len, job->out + begin, stats);
+        break;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Claim and process chunks until the job is done.
+ */
+static void work(void *ctx, unsigned worker)
+{
+    job_t *job = (job_t *)ctx;
+
+    for (;;) {
+        size_t begin = atomic_fetch_add_explicit(&job->next, HAMMING_PARALLEL_CHUNK, memory_order_relaxed);
+        if (begin >= job->data_size) {
+            break;
+        }
+        size_t len = job->data_size - begin;
+        if (len > HAMMING_PARALLEL_CHUNK) {
+            len = HAMMING_PARALLEL_CHUNK;
+        }
+        run_chunk(job, begin, len, &job->stats[worker]);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if HAMMING_PARALLEL_PTHREADS
+
+static void *worker_main(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    w->work(w->ctx, w->index);
+    return NULL;
+}
+
+#elif HAMMING_PARALLEL_FREERTOS
+
+static void worker_main(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    w->work(w->ctx, w->index);
+    xSemaphoreGive(w->done);  // w and the job may be gone after this
+    vTaskDelete(NULL);
+}
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Number of threads to use when the caller passes 0.
+ */
+static unsigned default_threads(void)
+{
+#if HAMMING_PARALLEL_PTHREADS
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return (online > 0) ? (unsigned)online : 1;
+#elif HAMMING_PARALLEL_FREERTOS
+    return portNUM_PROCESSORS;
+#else
+    return 1;
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run a job on up to threads threads and add the per-worker stats to stats.
+ */
+static void run_job(job_kind_t kind, const uint8_t *in, size_t data_size, uint8_t *out,
+                    unsigned threads, hamming_stats_t *stats)
+{
+    job_t job = {kind, in, out, data_size, 0, {{0, 0}}};
+
+    size_t chunks = (data_size + HAMMING_PARALLEL_CHUNK - 1) / HAMMING_PARALLEL_CHUNK;
+    unsigned workers = hamming_parallel_run(work, &job, threads, chunks);
+
+    if (stats != NULL) {
+        for (unsigned t = 0; t < workers; t++) {
+            stats->corrected += job.stats[t].corrected;
+            stats->uncorrectable += job.stats[t].uncorrectable;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Worker Threads   ----------------   */
+/*-----------------------------------------------------------*/
+
+unsigned hamming_parallel_run(void (*fn)(void *ctx, unsigned worker), void *ctx, unsigned threads,
+                              size_t units)
+{
+    if (threads == 0) {
+        threads = default_threads();
+    }
+    if (threads > HAMMING_PARALLEL_MAX_THREADS) {
+        threads = HAMMING_PARALLEL_MAX_THREADS;
+    }
+
+    // No point in more threads than units of work
+    if (threads > units) {
+        threads = (units > 0) ? (unsigned)units : 1;
+    }
+
+    // Resolve the engine before any worker races to do it
+    (void)hamming74_engine_ops();
+
+    worker_t workers[HAMMING_PARALLEL_MAX_THREADS];
+    unsigned started = 0;
+
+#if HAMMING_PARALLEL_PTHREADS
+    pthread_t handles[HAMMING_PARALLEL_MAX_THREADS];
+    for (unsigned t = 1; t < threads; t++) {
+        workers[t] = (worker_t){fn, ctx, t};
+        if (pthread_create(&handles[t], NULL, worker_main, &workers[t]) != 0) {
+            break;  // The threads already running and the caller finish the job
+        }
+        started = t;
+    }
+#elif HAMMING_PARALLEL_FREERTOS
+    // Not the task notification, which the caller's own code may be using
+    SemaphoreHandle_t done = (threads > 1) ? xSemaphoreCreateCounting(threads - 1, 0) : NULL;
+    if (done == NULL) {
+        threads = 1;
+    }
+    BaseType_t core = xPortGetCoreID();
+    for (unsigned t = 1; t < threads; t++) {
+        workers[t] = (worker_t){fn, ctx, t, done};
+        BaseType_t other = (core + t) % portNUM_PROCESSORS;
+        if (xTaskCreatePinnedToCore(worker_main, "hamming", 3072, &workers[t],
+                                    uxTaskPriorityGet(NULL), NULL, other) != pdPASS) {
+            break;
+        }
+        started = t;
+    }
+#else
+    (void)workers;
+#endif
+
+    fn(ctx, 0);
+
+#if HAMMING_PARALLEL_PTHREADS
+    for (unsigned t = 1; t <= started; t++) {
+        pthread_join(handles[t], NULL);
+    }
+#elif HAMMING_PARALLEL_FREERTOS
+    for (unsigned t = 1; t <= started; t++) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    if (done != NULL) {
+        vSemaphoreDelete(done);
+    }
+#endif
+
+    return started + 1;
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+void hamming74_encode_bytes_parallel(const uint8_t *data, size_t data_size, uint8_t *codewords,
+                                     unsigned threads)
+{
+    run_job(JOB_ENCODE_74, data, data_size, codewords, threads, NULL);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_decode_bytes_parallel(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                       unsigned threads)
+{
+    hamming_stats_t stats = {0, 0};
+    run_job(JOB_DECODE_74, codewords, data_size, data, threads, &stats);
+    return stats.corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming84_encode_bytes_parallel(const uint8_t *data, size_t data_size, uint8_t *codewords,
+                                     unsigned threads)
+{
+    run_job(JOB_ENCODE_84, data, data_size, codewords, threads, NULL);
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming84_decode_bytes_parallel(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                    unsigned threads, hamming_stats_t *stats)
+{
+    hamming_stats_t local = {0, 0};
+    run_job(JOB_DECODE_84, codewords, data_size, data, threads, &local);
+
+    if (stats != NULL) {
+        stats->corrected += local.corrected;
+        stats->uncorrectable += local.uncorrectable;
+    }
+    return (local.uncorrectable != 0) ? -1 : 0;
+}
+
+/*-----------------------------------------------------------*/
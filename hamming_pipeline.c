@@ -0,0 +1,390 @@
+/**
+ * @file hamming_pipeline.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Dual-core encode/decode pipeline for ESP-IDF.
+ *
+ * The worker task drains the input ring through a hamming74_stream_t into
+ * the output ring. It sleeps on its task notification, which both ends
+ * give: the producer after adding input and the consumer after freeing
+ * output space. The rings use C11 acquire/release atomics only, so neither
+ * side takes a lock or enters a critical section.
+ *
+ * A flush records the input ring's head in a small queue of marks. The
+ * worker never lets a stream update run past the oldest mark and ends the
+ * frame once it has read up to it, so input written after the flush always
+ * starts a new frame, however early it arrives.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#endif
+
+#if CONFIG_HAMMING_PIPELINE
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "hamming_pipeline.h"
+#include "hamming_private.h"
+
+/** Input bytes the worker takes per stream update. */
+#define PIPELINE_CHUNK CONFIG_HAMMING_PIPELINE_CHUNK
+
+/** Stack of the worker task, the chunk buffers live on it. */
+#define PIPELINE_STACK (2048 + 3 * PIPELINE_CHUNK)
+
+/** Size of the flush mark queue, a power of two. */
+#define PIPELINE_FLUSHES HAMMING_PIPELINE_MAX_FLUSHES
+
+/*-----------------------------------------------------------*/
+/*   ---------------   SPSC Ring Buffer   ----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Byte ring for one producer and one consumer.
+ *
+ * head and tail run freely and are reduced with mask, so head - tail is the
+ * fill level even after they wrap.
+ */
+typedef struct {
+    uint8_t *buf;
+    size_t mask;
+    _Atomic size_t head;  // Written by the producer only
+    _Atomic size_t tail;  // Written by the consumer only
+} ring_t;
+
+static int ring_init(ring_t *r, size_t capacity)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+    r->buf = malloc(capacity);
+    if (r->buf == NULL) {
+        return -1;
+    }
+    r->mask = capacity - 1;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/** Bytes the consumer can read. */
+static size_t ring_used(ring_t *r)
+{
+    return atomic_load_explicit(&r->head, memory_order_acquire) -
+           atomic_load_explicit(&r->tail, memory_order_relaxed);
+}
+
+/*-----------------------------------------------------------*/
+
+/** Bytes the producer can write. */
+static size_t ring_free(ring_t *r)
+{
+    return r->mask + 1 - (atomic_load_explicit(&r->head, memory_order_relaxed) -
+                          atomic_load_explicit(&r->tail, memory_order_acquire));
+}
+
+/*-----------------------------------------------------------*/
+
+/** Producer side, copies up to len bytes in. */
+static size_t ring_write(ring_t *r, const uint8_t *src, size_t len)
+{
+    size_t free = ring_free(r);
+    if (len > free) {
+        len = free;
+    }
+
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    size_t at = head & r->mask;
+    size_t first = (len < r->mask + 1 - at) ? len : r->mask + 1 - at;
+    memcpy(r->buf + at, src, first);
+    memcpy(r->buf, src + first, len - first);
+
+    // Publish the bytes before the new head
+    atomic_store_explicit(&r->head, head + len, memory_order_release);
+    return len;
+}
+
+/*-----------------------------------------------------------*/
+
+/** Consumer side, copies up to len bytes out. */
+static size_t ring_read(ring_t *r, uint8_t *dst, size_t len)
+{
+    size_t used = ring_used(r);
+    if (len > used) {
+        len = used;
+    }
+
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    size_t at = tail & r->mask;
+    size_t first = (len < r->mask + 1 - at) ? len : r->mask + 1 - at;
+    memcpy(dst, r->buf + at, first);
+    memcpy(dst + first, r->buf, len - first);
+
+    // Release the space only after the bytes have been copied out
+    atomic_store_explicit(&r->tail, tail + len, memory_order_release);
+    return len;
+}
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Worker Task   ---------------------   */
+/*-----------------------------------------------------------*/
+
+struct hamming_pipeline {
+    ring_t in;
+    ring_t out;
+    hamming74_stream_t stream;
+    hamming_pipeline_config_t config;
+    TaskHandle_t task;
+    SemaphoreHandle_t exited;   // Given by the worker when it stops
+    _Atomic size_t corrected;   // Mirror of stream.corrected for other tasks
+    size_t marks[PIPELINE_FLUSHES];  // in.head at each pending flush
+    _Atomic size_t mark_head;   // Written by the producer only
+    _Atomic size_t mark_tail;   // Written by the worker only
+    atomic_bool stop;
+};
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Largest input chunk whose output fits in room bytes.
+ */
+static size_t chunk_for_room(const hamming74_stream_t *s, size_t avail, size_t room)
+{
+    size_t len = (avail < PIPELINE_CHUNK) ? avail : PIPELINE_CHUNK;
+
+    // Encoding at most doubles the size, decoding at least halves it
+    while (len > 0 && hamming74_stream_output_size(s, len) > room) {
+        len = (len > 2) ? len / 2 : len - 1;
+    }
+    return len;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Oldest pending flush mark, returns 0 if there is none.
+ */
+static int next_mark(hamming_pipeline_t *p, size_t *mark)
+{
+    size_t tail = atomic_load_explicit(&p->mark_tail, memory_order_relaxed);
+    if (atomic_load_explicit(&p->mark_head, memory_order_acquire) == tail) {
+        return 0;
+    }
+    *mark = p->marks[tail & (PIPELINE_FLUSHES - 1)];
+    return 1;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief End the current frame and start the next one, returns non-zero if output was added.
+ */
+static int finish_frame(hamming_pipeline_t *p)
+{
+    uint8_t last;
+    int produced = 0;
+    if (hamming74_stream_final(&p->stream, &last) != 0) {
+        ring_write(&p->out, &last, 1);
+        produced = 1;
+    }
+    size_t corrected = p->stream.corrected;
+    hamming74_stream_init(&p->stream, p->config.mode, p->config.format);
+    p->stream.corrected = corrected;
+
+    // Hand the slot back to the producer only after its mark has been used
+    atomic_fetch_add_explicit(&p->mark_tail, 1, memory_order_release);
+    return produced;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Move as much data as possible through the stream, returns non-zero if output was added.
+ */
+static int pump(hamming_pipeline_t *p)
+{
+    uint8_t in[PIPELINE_CHUNK];
+    uint8_t out[2 * PIPELINE_CHUNK];
+    int produced = 0;
+
+    for (;;) {
+        size_t avail = ring_used(&p->in);
+        size_t mark;
+        if (next_mark(p, &mark)) {
+            size_t before = mark - atomic_load_explicit(&p->in.tail, memory_order_relaxed);
+            if (before == 0) {
+                // The frame's input is fully consumed, end it once the padding byte fits
+                if (ring_free(&p->out) < 1) {
+                    break;
+                }
+                produced |= finish_frame(p);
+                continue;
+            }
+            if (avail > before) {
+                avail = before;
+            }
+        }
+
+        size_t len = chunk_for_room(&p->stream, avail, ring_free(&p->out));
+        if (len == 0) {
+            break;
+        }
+        ring_read(&p->in, in, len);
+        size_t n = hamming74_stream_update(&p->stream, in, len, out);
+        ring_write(&p->out, out, n);
+        produced |= (n != 0);
+    }
+
+    atomic_store_explicit(&p->corrected, p->stream.corrected, memory_order_relaxed);
+    return produced;
+}
+
+/*-----------------------------------------------------------*/
+
+static void pipeline_task(void *arg)
+{
+    hamming_pipeline_t *p = (hamming_pipeline_t *)arg;
+
+    while (!atomic_load(&p->stop)) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (pump(p) && p->config.on_output != NULL) {
+            p->config.on_output(p->config.ctx);
+        }
+    }
+
+    xSemaphoreGive(p->exited);  // p may be freed after this
+    vTaskDelete(NULL);
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+hamming_pipeline_t *hamming_pipeline_create(const hamming_pipeline_config_t *config)
+{
+    hamming_pipeline_t *p = calloc(1, sizeof(*p));
+    if (p == NULL) {
+        return NULL;
+    }
+
+    if (ring_init(&p->in, config->in_capacity) != 0) {
+        free(p);
+        return NULL;
+    }
+    if (ring_init(&p->out, config->out_capacity) != 0) {
+        free(p->in.buf);
+        free(p);
+        return NULL;
+    }
+    p->exited = xSemaphoreCreateBinary();
+    if (p->exited == NULL) {
+        free(p->out.buf);
+        free(p->in.buf);
+        free(p);
+        return NULL;
+    }
+
+    p->config = *config;
+    hamming74_stream_init(&p->stream, config->mode, config->format);
+    atomic_init(&p->corrected, 0);
+    atomic_init(&p->mark_head, 0);
+    atomic_init(&p->mark_tail, 0);
+    atomic_init(&p->stop, false);
+
+    // Resolve the engine here rather than on the worker's first chunk
+    (void)hamming74_engine_ops();
+
+    if (xTaskCreatePinnedToCore(pipeline_task, "hamming_pipe", PIPELINE_STACK, p,
+                                config->priority, &p->task, config->core) != pdPASS) {
+        vSemaphoreDelete(p->exited);
+        free(p->out.buf);
+        free(p->in.buf);
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_pipeline_destroy(hamming_pipeline_t *pipeline)
+{
+    if (pipeline == NULL) {
+        return;
+    }
+
+    // Not the caller's task notification, on_output or the application may have left one pending
+    atomic_store(&pipeline->stop, true);
+    xTaskNotifyGive(pipeline->task);
+    xSemaphoreTake(pipeline->exited, portMAX_DELAY);
+
+    vSemaphoreDelete(pipeline->exited);
+    free(pipeline->out.buf);
+    free(pipeline->in.buf);
+    free(pipeline);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_pipeline_write(hamming_pipeline_t *pipeline, const uint8_t *data, size_t len)
+{
+    size_t n = ring_write(&pipeline->in, data, len);
+    if (n != 0) {
+        xTaskNotifyGive(pipeline->task);
+    }
+    return n;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_pipeline_read(hamming_pipeline_t *pipeline, uint8_t *out, size_t len)
+{
+    size_t n = ring_read(&pipeline->out, out, len);
+    if (n != 0) {
+        // The worker may be stalled on a full output ring
+        xTaskNotifyGive(pipeline->task);
+    }
+    return n;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming_pipeline_flush(hamming_pipeline_t *pipeline)
+{
+    size_t head = atomic_load_explicit(&pipeline->mark_head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&pipeline->mark_tail, memory_order_acquire) == PIPELINE_FLUSHES) {
+        return -1;
+    }
+
+    // Only the writer moves in.head, so this is exactly where the frame ends
+    pipeline->marks[head & (PIPELINE_FLUSHES - 1)] =
+        atomic_load_explicit(&pipeline->in.head, memory_order_relaxed);
+    atomic_store_explicit(&pipeline->mark_head, head + 1, memory_order_release);
+    xTaskNotifyGive(pipeline->task);
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_pipeline_corrected(const hamming_pipeline_t *pipeline)
+{
+    return atomic_load_explicit(&pipeline->corrected, memory_order_relaxed);
+}
+
+/*-----------------------------------------------------------*/
+
+#endif  // CONFIG_HAMMING_PIPELINE
@@ -0,0 +1,395 @@
+/**
+ * @file hamming_private.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Internal definitions shared between the codec translation units.
+ *
+ * @note
+ *  Not part of the public API, only included by the library sources.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_PRIVATE_H__
+#define __HAMMING_PRIVATE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hamming.h"
+
+/** Shuffle-based x86 kernels, built with per-function target attributes. */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HAMMING_HAVE_X86_SIMD 1
+#else
+#define HAMMING_HAVE_X86_SIMD 0
+#endif
+
+/** Shuffle-based NEON kernels, vqtbl1q_u8 requires AArch64. */
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define HAMMING_HAVE_NEON 1
+#else
+#define HAMMING_HAVE_NEON 0
+#endif
+
+#if defined(ESP_PLATFORM)
+#include "esp_attr.h"
+#include "sdkconfig.h"
+#endif
+
+/** Engines that can be compiled out from menuconfig, always built elsewhere. */
+#if defined(CONFIG_HAMMING_DISABLE_SCALAR)
+#define HAMMING_HAVE_SCALAR 0
+#else
+#define HAMMING_HAVE_SCALAR 1
+#endif
+
+#if defined(CONFIG_HAMMING_DISABLE_BITSLICE)
+#define HAMMING_HAVE_BITSLICE 0
+#else
+#define HAMMING_HAVE_BITSLICE 1
+#endif
+
+/*
+ * Placement of the encode and decode paths. With CONFIG_HAMMING_IN_IRAM the
+ * code goes to IRAM and its tables to DRAM so it can run with the flash cache
+ * disabled, and the inline helpers are forced inline so they cannot end up
+ * as out-of-line copies in flash.
+ */
+#if defined(CONFIG_HAMMING_IN_IRAM)
+#define HAMMING_IRAM_ATTR IRAM_ATTR
+#define HAMMING_DRAM_ATTR DRAM_ATTR
+#define HAMMING_INLINE FORCE_INLINE_ATTR
+#else
+#define HAMMING_IRAM_ATTR
+#define HAMMING_DRAM_ATTR
+#define HAMMING_INLINE static inline
+#endif
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Lookup Tables   ------------------   */
+/*-----------------------------------------------------------*/
+
+/** Hamming(7,4) codeword for every nibble, see hamming.c for the layout. */
+extern const uint8_t hamming74_encode_table[16];
+
+/** Corrected nibble (bits 0..3) and syndrome (bits 4..6) for every codeword. */
+extern const uint8_t hamming74_decode_table[128];
+
+/** Hamming(8,4) SECDED codeword for every nibble, bit 7 is the extended parity. */
+extern const uint8_t hamming84_encode_table[16];
+
+/** Nibble (bits 0..3) and status flags for every SECDED codeword. */
+extern const uint8_t hamming84_decode_table[256];
+
+/** hamming84_decode_table flag: a single-bit error was corrected. */
+#define HAMMING84_CORRECTED 0x10
+
+/** hamming84_decode_table flag: a double-bit error was detected. */
+#define HAMMING84_UNCORRECTABLE 0x20
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Codec Kernels   ------------------   */
+/*-----------------------------------------------------------*/
+
+/*
+ * Every kernel has the semantics of hamming74_encode_bytes() or
+ * hamming74_decode_bytes_ex() and produces bit-identical output.
+ */
+
+#if HAMMING_HAVE_SCALAR
+/** Reference kernels built on parity_check(), the baseline for the others. */
+void hamming74_scalar_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+size_t hamming74_scalar_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                               uint8_t *syndromes);
+int hamming74_scalar_is_clean(const uint8_t *codewords, size_t count);
+#endif
+
+/** Table-driven kernels, one lookup per codeword, clean words of 8 codewords skip the lookups. */
+void hamming74_table_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+size_t hamming74_table_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                              uint8_t *syndromes);
+
+/** Branch-free decode of 8 codewords per 64-bit word, the same cycles for every input of a given size. */
+size_t hamming74_consttime_decode(const uint8_t *codewords, size_t data_size, uint8_t *data, uint8_t *syndromes);
+
+/** Syndrome-only check of 8 codewords per 64-bit word, also used for kernel tails. */
+int hamming74_swar_is_clean(const uint8_t *codewords, size_t count);
+
+#if HAMMING_HAVE_BITSLICE
+/** Bit-sliced kernels, 128 codewords per block of 64-bit parity words. */
+void hamming74_bitslice_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+size_t hamming74_bitslice_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                 uint8_t *syndromes);
+#endif
+
+#if HAMMING_HAVE_X86_SIMD
+/** pshufb kernels, 16 (SSSE3) or 32 (AVX2) data bytes per iteration. */
+void hamming74_ssse3_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+size_t hamming74_ssse3_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                              uint8_t *syndromes);
+int hamming74_ssse3_is_clean(const uint8_t *codewords, size_t count);
+void hamming74_avx2_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+size_t hamming74_avx2_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                             uint8_t *syndromes);
+int hamming74_avx2_is_clean(const uint8_t *codewords, size_t count);
+#endif
+
+#if HAMMING_HAVE_NEON
+/** vqtbl1q_u8 kernels, 16 data bytes per iteration. */
+void hamming74_neon_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+size_t hamming74_neon_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                             uint8_t *syndromes);
+int hamming74_neon_is_clean(const uint8_t *codewords, size_t count);
+#endif
+
+/** Hamming(8,4) SECDED table kernels, statistics are added to stats. */
+void hamming84_table_encode(const uint8_t *data, size_t data_size, uint8_t *codewords);
+void hamming84_table_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                            hamming_stats_t *stats);
+
+/**
+ * @brief Copy the data bits of error-free codewords, no syndrome or correction.
+ *
+ * Works for Hamming(7,4) and (8,4) codewords alike, bit 7 is ignored.
+ */
+void hamming_extract_bytes(const uint8_t *codewords, size_t data_size, uint8_t *data);
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Engine Dispatch   ----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Kernels implementing one hamming74_engine_t.
+ *
+ * decode must allow data == codewords: every block of codewords is read
+ * before the data bytes it produces are stored.
+ */
+typedef struct {
+    hamming74_engine_t id;
+    const char *name;
+    void (*encode)(const uint8_t *data, size_t data_size, uint8_t *codewords);
+    size_t (*decode)(const uint8_t *codewords, size_t data_size, uint8_t *data, uint8_t *syndromes);
+    int (*is_clean)(const uint8_t *codewords, size_t count);
+} hamming74_engine_ops_t;
+
+/**
+ * @brief The engine used by the byte API, resolved on first use.
+ */
+const hamming74_engine_ops_t *hamming74_engine_ops(void);
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Worker Threads   ----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * Upper bound on worker threads, including the caller. It sizes arrays on the
+ * caller's stack, so on ESP-IDF it is the number of cores.
+ */
+#if defined(ESP_PLATFORM)
+#include "freertos/FreeRTOS.h"
+#define HAMMING_PARALLEL_MAX_THREADS portNUM_PROCESSORS
+#else
+#define HAMMING_PARALLEL_MAX_THREADS 64
+#endif
+
+/**
+ * @brief Run fn(ctx, worker) on up to threads threads, see hamming_parallel.c.
+ *
+ * The caller is worker 0, the others get 1 .. n - 1. Workers share the work
+ * through ctx, so if a thread cannot be started the rest simply do more.
+ *
+ * @param threads Threads including the caller, 0 for one per core.
+ * @param units Units of work, no more threads than that are started.
+ * @return n, the number of workers that ran.
+ */
+unsigned hamming_parallel_run(void (*fn)(void *ctx, unsigned worker), void *ctx, unsigned threads,
+                              size_t units);
+
+/*-----------------------------------------------------------*/
+/*   ----------------   Instrumentation   ----------------   */
+/*-----------------------------------------------------------*/
+
+#if defined(CONFIG_HAMMING_COUNTERS)
+#define HAMMING_HAVE_COUNTERS 1
+#else
+#define HAMMING_HAVE_COUNTERS 0
+#endif
+
+#if HAMMING_HAVE_COUNTERS
+
+/** Current cycle count (ESP-IDF) or monotonic nanoseconds, for timing an entry point. */
+uint64_t hamming_counters_now(void);
+
+/** Add one encode call to the slot of the calling core. */
+void hamming_counters_add_encode(size_t codewords, uint64_t start);
+
+/** Add one decode or correct call to the slot of the calling core. */
+void hamming_counters_add_decode(size_t codewords, size_t corrected, size_t uncorrectable, uint64_t start);
+
+#if defined(CONFIG_HAMMING_COUNTERS_TIMING)
+#define HAMMING_COUNT_START(t) const uint64_t t = hamming_counters_now()
+#else
+#define HAMMING_COUNT_START(t) const uint64_t t = 0
+#endif
+#define HAMMING_COUNT_ENCODE(t, codewords) hamming_counters_add_encode((codewords), (t))
+#define HAMMING_COUNT_DECODE(t, codewords, corrected, uncorrectable) \
+    hamming_counters_add_decode((codewords), (corrected), (uncorrectable), (t))
+
+#else
+
+// Compiled out, the entry points carry no instrumentation
+#define HAMMING_COUNT_START(t) ((void)0)
+#define HAMMING_COUNT_ENCODE(t, codewords) ((void)0)
+#define HAMMING_COUNT_DECODE(t, codewords, corrected, uncorrectable) ((void)0)
+
+#endif  // HAMMING_HAVE_COUNTERS
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Load 8 bytes as a little-endian 64-bit word (byte 0 in bits 0..7).
+ */
+HAMMING_INLINE uint64_t hamming_load64_le(const uint8_t *p)
+{
+    return (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) |
+           ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+}
+
+/**
+ * @brief Store a 64-bit word as 8 little-endian bytes.
+ */
+HAMMING_INLINE void hamming_store64_le(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+/**
+ * @brief Load 7 bytes as a big-endian 56-bit word (byte 0 in bits 48..55).
+ */
+HAMMING_INLINE uint64_t hamming_load56_be(const uint8_t *p)
+{
+    return ((uint64_t)p[0] << 48) | ((uint64_t)p[1] << 40) | ((uint64_t)p[2] << 32) |
+           ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 16) | ((uint64_t)p[5] << 8) |
+           (uint64_t)p[6];
+}
+
+/**
+ * @brief Store the low 56 bits of a word as 7 big-endian bytes.
+ */
+HAMMING_INLINE void hamming_store56_be(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 7; i++) {
+        p[i] = (uint8_t)(v >> (48 - 8 * i));
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Transpose an 8x8 bit matrix held in a 64-bit word.
+ *
+ * Row r is byte r and column c is bit c, so bit (8r + c) moves to (8c + r).
+ */
+HAMMING_INLINE uint64_t hamming_transpose8(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Parity of every byte of a 64-bit word.
+ *
+ * @return Bit 0 of every byte is the XOR of the 8 bits of that byte, all other bits are 0.
+ */
+HAMMING_INLINE uint64_t hamming_byte_parity64(uint64_t x)
+{
+    // The shifts only carry neighbouring bytes into bits 4..7, which are discarded
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 0x0101010101010101ULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Syndrome bits of 8 Hamming(7,4) codewords, one per byte.
+ *
+ * @return Zero if all 8 codewords are clean. Bit 7 of the input is ignored.
+ */
+HAMMING_INLINE uint64_t hamming74_dirty64(uint64_t w)
+{
+    // P1, P2 and P4 cover bits 6,4,2,0 / 5,4,1,0 / 3,2,1,0 of every codeword
+    return hamming_byte_parity64(w & 0x5555555555555555ULL) |
+           hamming_byte_parity64(w & 0x3333333333333333ULL) |
+           hamming_byte_parity64(w & 0x0F0F0F0F0F0F0F0FULL);
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Data bytes of 8 error-free codewords loaded little-endian.
+ *
+ * @return The 4 data bytes in bits 0..31, first byte in bits 0..7.
+ */
+HAMMING_INLINE uint32_t hamming_gather_nibbles64(uint64_t w)
+{
+    // D1 sits in bit 4, D2..D4 in bits 2..0
+    uint64_t n = ((w >> 1) & 0x0808080808080808ULL) | (w & 0x0707070707070707ULL);
+
+    // Even bytes are high nibbles, odd bytes low nibbles
+    n = ((n & 0x00FF00FF00FF00FFULL) << 4) | ((n >> 8) & 0x00FF00FF00FF00FFULL);
+    n = (n | (n >> 8)) & 0x0000FFFF0000FFFFULL;
+    n = (n | (n >> 16)) & 0x00000000FFFFFFFFULL;
+    return (uint32_t)n;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count the set bits of a 64-bit word.
+ */
+HAMMING_INLINE unsigned hamming_popcount64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (unsigned)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Parity (XOR of all bits) of a 64-bit word.
+ */
+HAMMING_INLINE unsigned hamming_parity64(uint64_t x)
+{
+#if defined(__GNUC__)
+    return (unsigned)__builtin_parityll(x);
+#else
+    return hamming_popcount64(x) & 1;
+#endif
+}
+
+#endif  // __HAMMING_PRIVATE_H__
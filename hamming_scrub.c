@@ -0,0 +1,147 @@
+/**
+ * @file hamming_scrub.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Incremental background scrubbing of ECC-protected memory.
+ *
+ * Each tick spends its codeword budget on the current region from its
+ * cursor on, then moves on to the next region, so every region is visited
+ * within (total codewords / budget) ticks. The per-codeword work is
+ * hamming74_correct_bytes() or hamming84_correct_bytes(), which skip clean
+ * words after a syndrome-only check and write back corrected codewords only.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_scrub.h"
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Scrub up to len codewords of a region from its cursor.
+ *
+ * The repairs are added to the region and to tick.
+ */
+static void scrub_span(hamming_scrub_region_t *region, size_t len, hamming_stats_t *tick)
+{
+    uint8_t *start = region->codewords + region->cursor;
+    hamming_stats_t local = {0, 0};
+
+    if (region->code == HAMMING_SCRUB_84) {
+        hamming84_correct_bytes(start, len, &local);
+    } else {
+        local.corrected = hamming74_correct_bytes(start, len);
+    }
+
+    region->cursor += len;
+    region->stats.corrected += local.corrected;
+    region->stats.uncorrectable += local.uncorrectable;
+    tick->corrected += local.corrected;
+    tick->uncorrectable += local.uncorrectable;
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+void hamming_scrub_init(hamming_scrubber_t *scrubber, size_t codewords_per_tick)
+{
+    scrubber->head = NULL;
+    scrubber->current = NULL;
+    scrubber->budget = codewords_per_tick;
+    scrubber->passes = 0;
+    scrubber->stats.corrected = 0;
+    scrubber->stats.uncorrectable = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_scrub_region_init(hamming_scrub_region_t *region, hamming_scrub_code_t code,
+                               uint8_t *codewords, size_t count)
+{
+    region->next = NULL;
+    region->codewords = codewords;
+    region->count = count;
+    region->cursor = 0;
+    region->code = code;
+    region->stats.corrected = 0;
+    region->stats.uncorrectable = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_scrub_add(hamming_scrubber_t *scrubber, hamming_scrub_region_t *region)
+{
+    region->next = scrubber->head;
+    region->cursor = 0;
+    scrubber->head = region;
+    if (scrubber->current == NULL) {
+        scrubber->current = region;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming_scrub_remove(hamming_scrubber_t *scrubber, hamming_scrub_region_t *region)
+{
+    for (hamming_scrub_region_t **link = &scrubber->head; *link != NULL; link = &(*link)->next) {
+        if (*link == region) {
+            *link = region->next;
+            break;
+        }
+    }
+
+    if (scrubber->current == region) {
+        scrubber->current = (region->next != NULL) ? region->next : scrubber->head;
+    }
+    region->next = NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming_scrub_tick(hamming_scrubber_t *scrubber)
+{
+    hamming_scrub_region_t *first = scrubber->current;
+    hamming_stats_t tick = {0, 0};
+    size_t budget = scrubber->budget;
+
+    while (budget > 0 && scrubber->current != NULL) {
+        hamming_scrub_region_t *region = scrubber->current;
+
+        size_t len = region->count - region->cursor;
+        if (len > budget) {
+            len = budget;
+        }
+        scrub_span(region, len, &tick);
+        budget -= len;
+
+        if (region->cursor < region->count) {
+            break;  // Budget used up inside this region
+        }
+
+        // Region done, continue with the next one and wrap around to the head
+        region->cursor = 0;
+        if (region->next != NULL) {
+            scrubber->current = region->next;
+        } else {
+            scrubber->current = scrubber->head;
+            scrubber->passes++;
+        }
+
+        // A budget larger than all regions together checks everything once
+        if (scrubber->current == first) {
+            break;
+        }
+    }
+
+    scrubber->stats.corrected += tick.corrected;
+    scrubber->stats.uncorrectable += tick.uncorrectable;
+    return tick.corrected;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,445 @@
+/**
+ * @file hamming_simd.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Shuffle-based SIMD Hamming(7,4) codec kernels (SSSE3, AVX2, NEON).
+ *
+ * The 16-entry codeword table fits in a single vector register, so a
+ * byte shuffle (pshufb / vqtbl1q_u8) encodes 16 or 32 nibbles at once.
+ * Decoding splits each codeword into its upper 3 and lower 4 bits, looks up
+ * the two partial syndromes, XORs them and applies the correction with a
+ * third shuffle.
+ *
+ * @note
+ *  Output is bit-identical to the table kernels in hamming.c. Input that does
+ *  not fill a whole vector is handed to the table kernels. The x86 kernels
+ *  use per-function target attributes and need no extra compiler flags.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_private.h"
+
+#if HAMMING_HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#if HAMMING_HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+#if HAMMING_HAVE_X86_SIMD || HAMMING_HAVE_NEON
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Lookup Tables   ------------------   */
+/*-----------------------------------------------------------*/
+
+/** Syndrome contributed by codeword bits 3..0 (positions 4..7). */
+static const uint8_t syndrome_lo_table[16] = {
+    0, 7, 6, 1, 5, 2, 3, 4, 4, 3, 2, 5, 1, 6, 7, 0,
+};
+
+/** Syndrome contributed by codeword bits 6..4 (positions 1..3). */
+static const uint8_t syndrome_hi_table[16] = {
+    0, 3, 2, 1, 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+/** Bit to flip for every syndrome, position p lives in bit (7 - p). */
+static const uint8_t correction_table[16] = {
+    0x00, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+#endif  // HAMMING_HAVE_X86_SIMD || HAMMING_HAVE_NEON
+
+/*-----------------------------------------------------------*/
+/*   ---------------   SSSE3 Kernels   ------------------   */
+/*-----------------------------------------------------------*/
+
+#if HAMMING_HAVE_X86_SIMD
+
+/**
+ * @brief Syndromes of 16 codewords, bit 7 of the input is ignored.
+ */
+__attribute__((target("ssse3"))) static inline __m128i ssse3_syndromes(__m128i c)
+{
+    const __m128i syn_lo = _mm_loadu_si128((const __m128i *)syndrome_lo_table);
+    const __m128i syn_hi = _mm_loadu_si128((const __m128i *)syndrome_hi_table);
+    const __m128i low = _mm_set1_epi8(0x0F);
+
+    return _mm_xor_si128(_mm_shuffle_epi8(syn_hi, _mm_and_si128(_mm_srli_epi16(c, 4), _mm_set1_epi8(0x07))),
+                         _mm_shuffle_epi8(syn_lo, _mm_and_si128(c, low)));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Correct 16 codewords and return their data nibbles, one per byte.
+ *
+ * @param c The codewords.
+ * @param syndrome Output, the syndrome of every codeword.
+ */
+__attribute__((target("ssse3"))) static inline __m128i ssse3_decode_nibbles(__m128i c, __m128i *syndrome)
+{
+    const __m128i fix = _mm_loadu_si128((const __m128i *)correction_table);
+
+    // Bit 7 is not part of the codeword
+    c = _mm_and_si128(c, _mm_set1_epi8(0x7F));
+
+    __m128i s = ssse3_syndromes(c);
+    c = _mm_xor_si128(c, _mm_shuffle_epi8(fix, s));
+    *syndrome = s;
+
+    // D1 is bit 4, D2..D4 are bits 2..0
+    return _mm_or_si128(_mm_and_si128(_mm_srli_epi16(c, 1), _mm_set1_epi8(0x08)),
+                        _mm_and_si128(c, _mm_set1_epi8(0x07)));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Merge nibble pairs (even lane high, odd lane low) into bytes in the
+ *        low half of every 16-bit lane.
+ */
+__attribute__((target("ssse3"))) static inline __m128i ssse3_merge_nibbles(__m128i n)
+{
+    return _mm_and_si128(_mm_or_si128(_mm_slli_epi16(n, 4), _mm_srli_epi16(n, 8)),
+                         _mm_set1_epi16(0x00FF));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Count the non-zero bytes, i.e. the corrected codewords, of a syndrome vector.
+ */
+__attribute__((target("ssse3"))) static inline size_t ssse3_count_nonzero(__m128i s)
+{
+    unsigned zero = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(s, _mm_setzero_si128()));
+    return (size_t)hamming_popcount64(~zero & 0xFFFFu);
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__((target("ssse3"))) void hamming74_ssse3_encode(const uint8_t *data,
+                                                             size_t data_size,
+                                                             uint8_t *codewords)
+{
+    const __m128i table = _mm_loadu_si128((const __m128i *)hamming74_encode_table);
+    const __m128i low = _mm_set1_epi8(0x0F);
+    size_t done = 0;
+
+    for (; done + 16 <= data_size; done += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(data + done));
+        __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(v, 4), low));
+        __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(v, low));
+
+        // High nibble codeword first
+        _mm_storeu_si128((__m128i *)(codewords + 2 * done), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(codewords + 2 * done + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    hamming74_table_encode(data + done, data_size - done, codewords + 2 * done);
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__((target("ssse3"))) size_t hamming74_ssse3_decode(const uint8_t *codewords,
+                                                               size_t data_size,
+                                                               uint8_t *data,
+                                                               uint8_t *syndromes)
+{
+    size_t corrected = 0;
+    size_t done = 0;
+
+    for (; done + 16 <= data_size; done += 16) {
+        __m128i s0, s1;
+        __m128i n0 = ssse3_decode_nibbles(_mm_loadu_si128((const __m128i *)(codewords + 2 * done)), &s0);
+        __m128i n1 = ssse3_decode_nibbles(_mm_loadu_si128((const __m128i *)(codewords + 2 * done + 16)), &s1);
+
+        corrected += ssse3_count_nonzero(s0) + ssse3_count_nonzero(s1);
+        if (syndromes != NULL) {
+            _mm_storeu_si128((__m128i *)(syndromes + 2 * done), s0);
+            _mm_storeu_si128((__m128i *)(syndromes + 2 * done + 16), s1);
+        }
+
+        __m128i out = _mm_packus_epi16(ssse3_merge_nibbles(n0), ssse3_merge_nibbles(n1));
+        _mm_storeu_si128((__m128i *)(data + done), out);
+    }
+
+    corrected += hamming74_table_decode(codewords + 2 * done, data_size - done, data + done,
+                                        syndromes != NULL ? syndromes + 2 * done : NULL);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+/*   ----------------   AVX2 Kernels   ------------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief AVX2 version of ssse3_syndromes().
+ */
+__attribute__((target("avx2"))) static inline __m256i avx2_syndromes(__m256i c)
+{
+    const __m256i syn_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)syndrome_lo_table));
+    const __m256i syn_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)syndrome_hi_table));
+    const __m256i low = _mm256_set1_epi8(0x0F);
+
+    return _mm256_xor_si256(_mm256_shuffle_epi8(syn_hi, _mm256_and_si256(_mm256_srli_epi16(c, 4), _mm256_set1_epi8(0x07))),
+                            _mm256_shuffle_epi8(syn_lo, _mm256_and_si256(c, low)));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Correct 32 codewords and return their data nibbles, one per byte.
+ *
+ * @param c The codewords.
+ * @param syndrome Output, the syndrome of every codeword.
+ */
+__attribute__((target("avx2"))) static inline __m256i avx2_decode_nibbles(__m256i c, __m256i *syndrome)
+{
+    const __m256i fix = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)correction_table));
+
+    c = _mm256_and_si256(c, _mm256_set1_epi8(0x7F));
+
+    __m256i s = avx2_syndromes(c);
+    c = _mm256_xor_si256(c, _mm256_shuffle_epi8(fix, s));
+    *syndrome = s;
+
+    return _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(c, 1), _mm256_set1_epi8(0x08)),
+                           _mm256_and_si256(c, _mm256_set1_epi8(0x07)));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief AVX2 version of ssse3_merge_nibbles().
+ */
+__attribute__((target("avx2"))) static inline __m256i avx2_merge_nibbles(__m256i n)
+{
+    return _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi16(n, 4), _mm256_srli_epi16(n, 8)),
+                            _mm256_set1_epi16(0x00FF));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief AVX2 version of ssse3_count_nonzero().
+ */
+__attribute__((target("avx2"))) static inline size_t avx2_count_nonzero(__m256i s)
+{
+    uint32_t zero = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, _mm256_setzero_si256()));
+    return (size_t)hamming_popcount64(~zero);
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__((target("avx2"))) void hamming74_avx2_encode(const uint8_t *data,
+                                                           size_t data_size,
+                                                           uint8_t *codewords)
+{
+    const __m256i table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)hamming74_encode_table));
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    size_t done = 0;
+
+    for (; done + 32 <= data_size; done += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(data + done));
+        __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+        __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+
+        // Unpack works within 128-bit lanes, so reorder the lanes afterwards
+        __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i *)(codewords + 2 * done), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(codewords + 2 * done + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+
+    hamming74_ssse3_encode(data + done, data_size - done, codewords + 2 * done);
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__((target("avx2"))) size_t hamming74_avx2_decode(const uint8_t *codewords,
+                                                             size_t data_size,
+                                                             uint8_t *data,
+                                                             uint8_t *syndromes)
+{
+    size_t corrected = 0;
+    size_t done = 0;
+
+    for (; done + 32 <= data_size; done += 32) {
+        __m256i s0, s1;
+        __m256i n0 = avx2_decode_nibbles(_mm256_loadu_si256((const __m256i *)(codewords + 2 * done)), &s0);
+        __m256i n1 = avx2_decode_nibbles(_mm256_loadu_si256((const __m256i *)(codewords + 2 * done + 32)), &s1);
+
+        corrected += avx2_count_nonzero(s0) + avx2_count_nonzero(s1);
+        if (syndromes != NULL) {
+            _mm256_storeu_si256((__m256i *)(syndromes + 2 * done), s0);
+            _mm256_storeu_si256((__m256i *)(syndromes + 2 * done + 32), s1);
+        }
+
+        // Pack works within 128-bit lanes, so reorder the 64-bit quarters afterwards
+        __m256i out = _mm256_packus_epi16(avx2_merge_nibbles(n0), avx2_merge_nibbles(n1));
+        _mm256_storeu_si256((__m256i *)(data + done), _mm256_permute4x64_epi64(out, 0xD8));
+    }
+
+    corrected += hamming74_ssse3_decode(codewords + 2 * done, data_size - done, data + done,
+                                        syndromes != NULL ? syndromes + 2 * done : NULL);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__((target("ssse3"))) int hamming74_ssse3_is_clean(const uint8_t *codewords, size_t count)
+{
+    size_t done = 0;
+
+    for (; done + 64 <= count; done += 64) {
+        __m128i acc = _mm_setzero_si128();
+        for (int k = 0; k < 4; k++) {
+            acc = _mm_or_si128(acc, ssse3_syndromes(_mm_loadu_si128((const __m128i *)(codewords + done + 16 * k))));
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xFFFF) {
+            return 0;
+        }
+    }
+
+    return hamming74_swar_is_clean(codewords + done, count - done);
+}
+
+/*-----------------------------------------------------------*/
+
+__attribute__((target("avx2"))) int hamming74_avx2_is_clean(const uint8_t *codewords, size_t count)
+{
+    size_t done = 0;
+
+    for (; done + 128 <= count; done += 128) {
+        __m256i acc = _mm256_setzero_si256();
+        for (int k = 0; k < 4; k++) {
+            acc = _mm256_or_si256(acc, avx2_syndromes(_mm256_loadu_si256((const __m256i *)(codewords + done + 32 * k))));
+        }
+        if (!_mm256_testz_si256(acc, acc)) {
+            return 0;
+        }
+    }
+
+    return hamming74_ssse3_is_clean(codewords + done, count - done);
+}
+
+#endif  // HAMMING_HAVE_X86_SIMD
+
+/*-----------------------------------------------------------*/
+/*   ----------------   NEON Kernels   ------------------   */
+/*-----------------------------------------------------------*/
+
+#if HAMMING_HAVE_NEON
+
+/**
+ * @brief Syndromes of 16 codewords, bit 7 of the input is ignored.
+ */
+static inline uint8x16_t neon_syndromes(uint8x16_t c)
+{
+    const uint8x16_t syn_lo = vld1q_u8(syndrome_lo_table);
+    const uint8x16_t syn_hi = vld1q_u8(syndrome_hi_table);
+
+    return veorq_u8(vqtbl1q_u8(syn_hi, vandq_u8(vshrq_n_u8(c, 4), vdupq_n_u8(0x07))),
+                    vqtbl1q_u8(syn_lo, vandq_u8(c, vdupq_n_u8(0x0F))));
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Correct 16 codewords and return their data nibbles, one per byte.
+ *
+ * @param c The codewords.
+ * @param syndrome Output, the syndrome of every codeword.
+ */
+static inline uint8x16_t neon_decode_nibbles(uint8x16_t c, uint8x16_t *syndrome)
+{
+    const uint8x16_t fix = vld1q_u8(correction_table);
+
+    c = vandq_u8(c, vdupq_n_u8(0x7F));
+
+    uint8x16_t s = neon_syndromes(c);
+    c = veorq_u8(c, vqtbl1q_u8(fix, s));
+    *syndrome = s;
+
+    return vorrq_u8(vandq_u8(vshrq_n_u8(c, 1), vdupq_n_u8(0x08)),
+                    vandq_u8(c, vdupq_n_u8(0x07)));
+}
+
+/*-----------------------------------------------------------*/
+
+void hamming74_neon_encode(const uint8_t *data, size_t data_size, uint8_t *codewords)
+{
+    const uint8x16_t table = vld1q_u8(hamming74_encode_table);
+    size_t done = 0;
+
+    for (; done + 16 <= data_size; done += 16) {
+        uint8x16_t v = vld1q_u8(data + done);
+        uint8x16x2_t cw;
+        cw.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+        cw.val[1] = vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0x0F)));
+
+        // vst2 interleaves the high and low nibble codewords
+        vst2q_u8(codewords + 2 * done, cw);
+    }
+
+    hamming74_table_encode(data + done, data_size - done, codewords + 2 * done);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_neon_decode(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                             uint8_t *syndromes)
+{
+    size_t corrected = 0;
+    size_t done = 0;
+
+    for (; done + 16 <= data_size; done += 16) {
+        // vld2 splits even (high nibble) and odd (low nibble) codewords
+        uint8x16x2_t cw = vld2q_u8(codewords + 2 * done);
+        uint8x16x2_t s;
+        uint8x16_t hi = neon_decode_nibbles(cw.val[0], &s.val[0]);
+        uint8x16_t lo = neon_decode_nibbles(cw.val[1], &s.val[1]);
+
+        vst1q_u8(data + done, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+
+        // vtst yields 0xFF for every non-zero syndrome
+        uint8x16_t one = vdupq_n_u8(1);
+        corrected += vaddvq_u8(vandq_u8(vtstq_u8(s.val[0], s.val[0]), one)) +
+                     vaddvq_u8(vandq_u8(vtstq_u8(s.val[1], s.val[1]), one));
+        if (syndromes != NULL) {
+            vst2q_u8(syndromes + 2 * done, s);
+        }
+    }
+
+    corrected += hamming74_table_decode(codewords + 2 * done, data_size - done, data + done,
+                                        syndromes != NULL ? syndromes + 2 * done : NULL);
+    return corrected;
+}
+
+/*-----------------------------------------------------------*/
+
+int hamming74_neon_is_clean(const uint8_t *codewords, size_t count)
+{
+    size_t done = 0;
+
+    for (; done + 64 <= count; done += 64) {
+        uint8x16_t acc = vdupq_n_u8(0);
+        for (int k = 0; k < 4; k++) {
+            acc = vorrq_u8(acc, neon_syndromes(vld1q_u8(codewords + done + 16 * k)));
+        }
+        if (vmaxvq_u8(acc) != 0) {
+            return 0;
+        }
+    }
+
+    return hamming74_swar_is_clean(codewords + done, count - done);
+}
+
+#endif  // HAMMING_HAVE_NEON
+
+/*-----------------------------------------------------------*/
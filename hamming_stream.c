@@ -0,0 +1,198 @@
+/**
+ * @file hamming_stream.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Incremental Hamming(7,4) encoder/decoder for arbitrary-sized chunks.
+ *
+ * A hamming74_stream_t carries a dangling codeword (one-per-byte decode) or
+ * the bits of an incomplete 7-bit codeword (packed format) from one update
+ * call to the next. Chunks can therefore be as small as a single byte and no
+ * frame-sized buffer is needed.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#include "hamming_private.h"
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Encode into the packed format, 14 bits per input byte.
+ */
+static size_t encode_packed(hamming74_stream_t *s, const uint8_t *in, size_t len, uint8_t *out)
+{
+    size_t written = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        // Byte aligned again: hand whole 4-byte blocks to the packed kernel
+        if (s->bits == 0 && len - i >= 4) {
+            size_t bulk = (len - i) & ~(size_t)3;
+            written += hamming74_encode_packed(in + i, bulk, out + written);
+            i += bulk;
+            if (i == len) {
+                break;
+            }
+        }
+
+        uint32_t pair = ((uint32_t)hamming74_encode_table[in[i] >> 4] << 7) |
+                        hamming74_encode_table[in[i] & 0x0F];
+        s->acc = (s->acc << 14) | pair;
+        s->bits += 14;
+        while (s->bits >= 8) {
+            s->bits -= 8;
+            out[written++] = (uint8_t)(s->acc >> s->bits);
+        }
+    }
+
+    return written;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Feed one decoded nibble, returns 1 if it completed an output byte.
+ */
+static inline size_t push_nibble(hamming74_stream_t *s, uint8_t entry, uint8_t *out)
+{
+    s->corrected += (entry >> 4) != 0;
+    if (!s->have_half) {
+        s->half = entry & 0x0F;
+        s->have_half = 1;
+        return 0;
+    }
+    *out = (uint8_t)((s->half << 4) | (entry & 0x0F));
+    s->have_half = 0;
+    return 1;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Decode the one-codeword-per-byte format.
+ */
+static size_t decode_bytes(hamming74_stream_t *s, const uint8_t *in, size_t len, uint8_t *out)
+{
+    size_t written = 0;
+
+    // Complete a byte whose high nibble arrived in the previous chunk
+    if (s->have_half && len > 0) {
+        written += push_nibble(s, hamming74_decode_table[in[0] & 0x7F], out);
+        in++;
+        len--;
+    }
+
+    // Whole codeword pairs go through the byte API engine
+    size_t pairs = len / 2;
+    s->corrected += hamming74_decode_bytes(in, pairs, out + written);
+    written += pairs;
+
+    if (len % 2 != 0) {
+        push_nibble(s, hamming74_decode_table[in[len - 1] & 0x7F], out + written);
+    }
+
+    return written;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Decode the packed format, 7 bits per codeword.
+ */
+static size_t decode_packed(hamming74_stream_t *s, const uint8_t *in, size_t len, uint8_t *out)
+{
+    size_t written = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        // On a block boundary: hand whole 7-byte blocks to the packed kernel
+        if (s->bits == 0 && !s->have_half && len - i >= 7) {
+            size_t blocks = (len - i) / 7;
+            s->corrected += hamming74_decode_packed(in + i, 4 * blocks, out + written);
+            written += 4 * blocks;
+            i += 7 * blocks;
+            if (i == len) {
+                break;
+            }
+        }
+
+        s->acc = (s->acc << 8) | in[i];
+        s->bits += 8;
+        while (s->bits >= 7) {
+            s->bits -= 7;
+            uint8_t codeword = (uint8_t)((s->acc >> s->bits) & 0x7F);
+            written += push_nibble(s, hamming74_decode_table[codeword], out + written);
+        }
+    }
+
+    return written;
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------   API Functions    -----------------   */
+/*-----------------------------------------------------------*/
+
+void hamming74_stream_init(hamming74_stream_t *s, hamming74_stream_mode_t mode,
+                           hamming74_format_t format)
+{
+    s->mode = (uint8_t)mode;
+    s->format = (uint8_t)format;
+    s->half = 0;
+    s->have_half = 0;
+    s->bits = 0;
+    s->acc = 0;
+    s->corrected = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_stream_output_size(const hamming74_stream_t *s, size_t len)
+{
+    if (s->mode == HAMMING74_STREAM_ENCODE) {
+        return (s->format == HAMMING74_FORMAT_PACKED) ? (s->bits + 14 * len) / 8 : 2 * len;
+    }
+    size_t nibbles = (s->format == HAMMING74_FORMAT_PACKED) ? (s->bits + 8 * len) / 7 : len;
+    return (s->have_half + nibbles) / 2;
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_stream_update(hamming74_stream_t *s, const uint8_t *in, size_t len, uint8_t *out)
+{
+    if (s->mode == HAMMING74_STREAM_ENCODE) {
+        if (s->format == HAMMING74_FORMAT_PACKED) {
+            return encode_packed(s, in, len, out);
+        }
+        hamming74_encode_bytes(in, len, out);
+        return 2 * len;
+    }
+
+    if (s->format == HAMMING74_FORMAT_PACKED) {
+        return decode_packed(s, in, len, out);
+    }
+    return decode_bytes(s, in, len, out);
+}
+
+/*-----------------------------------------------------------*/
+
+size_t hamming74_stream_final(hamming74_stream_t *s, uint8_t *out)
+{
+    size_t written = 0;
+
+    // Zero-pad the last partial byte of a packed stream
+    if (s->mode == HAMMING74_STREAM_ENCODE && s->format == HAMMING74_FORMAT_PACKED && s->bits != 0) {
+        out[0] = (uint8_t)(s->acc << (8 - s->bits));
+        written = 1;
+    }
+
+    // Decoder padding bits and a dangling nibble are dropped
+    s->bits = 0;
+    s->acc = 0;
+    s->have_half = 0;
+    return written;
+}
+
+/*-----------------------------------------------------------*/
@@ -16,10 +16,119 @@
 #ifndef __HAMMING_H__
 #define __HAMMING_H__
 
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Codec engines behind the byte API.
+ *
+ * Every engine produces bit-identical output, they only differ in speed.
+ */
+typedef enum {
+    HAMMING74_ENGINE_AUTO = 0,  /**< Best engine available on this host. */
+    HAMMING74_ENGINE_SCALAR,    /**< Reference bit-by-bit implementation. */
+    HAMMING74_ENGINE_TABLE,     /**< One table lookup per codeword. */
+    HAMMING74_ENGINE_BITSLICE,  /**< Bit-sliced, 128 codewords per 64-bit block. */
+    HAMMING74_ENGINE_SSSE3,     /**< x86 pshufb, 16 bytes per iteration. */
+    HAMMING74_ENGINE_AVX2,      /**< x86 pshufb, 32 bytes per iteration. */
+    HAMMING74_ENGINE_NEON,      /**< AArch64 vqtbl1q_u8, 16 bytes per iteration. */
+    HAMMING74_ENGINE_CONSTTIME, /**< Branch-free decode, the same cycles for every input. */
+    HAMMING74_ENGINE_COUNT
+} hamming74_engine_t;
+
+/**
+ * @brief Error statistics accumulated by the decoders that can detect
+ *        uncorrectable errors.
+ */
+typedef struct {
+    size_t corrected;      /**< Codewords in which a single-bit error was corrected. */
+    size_t uncorrectable;  /**< Codewords with a detected, uncorrectable error. */
+} hamming_stats_t;
+
+/** Maximum number of Hamming parity bits supported by hamming_codec_t. */
+#define HAMMING_CODEC_MAX_R 7
+
+/**
+ * @brief Parameters of a generalized Hamming code, set up by hamming_codec_init().
+ */
+typedef struct {
+    uint8_t n;       /**< Codeword bits, including the extended parity bit. */
+    uint8_t k;       /**< Data bits per codeword. */
+    uint8_t r;       /**< Hamming parity bits, excluding the extended parity bit. */
+    uint8_t secded;  /**< Non-zero if an extended parity bit is added. */
+    uint64_t data_mask[HAMMING_CODEC_MAX_R];  /**< Data bits covered by parity bit 2^i. */
+} hamming_codec_t;
+
+/**
+ * @brief Direction of a hamming74_stream_t.
+ */
+typedef enum {
+    HAMMING74_STREAM_ENCODE = 0,  /**< Data bytes in, codewords out. */
+    HAMMING74_STREAM_DECODE,      /**< Codewords in, data bytes out. */
+} hamming74_stream_mode_t;
+
+/**
+ * @brief Codeword serialization used by the streaming API.
+ */
+typedef enum {
+    HAMMING74_FORMAT_BYTES = 0,  /**< One codeword per byte, as hamming74_encode_bytes(). */
+    HAMMING74_FORMAT_PACKED,     /**< Dense 7-bit codewords, MSB first, no padding between them. */
+} hamming74_format_t;
+
+/**
+ * @brief Streaming Hamming(7,4) encoder/decoder state.
+ *
+ * Fields are private except corrected, which counts corrected codewords
+ * since hamming74_stream_init().
+ */
+typedef struct {
+    uint8_t mode;      /**< hamming74_stream_mode_t */
+    uint8_t format;    /**< hamming74_format_t */
+    uint8_t half;      /**< Decoded high nibble waiting for its low nibble. */
+    uint8_t have_half; /**< Non-zero if half is valid. */
+    uint32_t acc;      /**< Bits of an incomplete packed byte or codeword. */
+    uint32_t bits;     /**< Number of valid bits in acc. */
+    size_t corrected;  /**< Codewords corrected so far (decode only). */
+} hamming74_stream_t;
+
+/**
+ * @brief Alignment of every slice handed out by a hamming_arena_t, at least 4 for DMA.
+ */
+#ifndef HAMMING_ARENA_ALIGN
+#define HAMMING_ARENA_ALIGN 4
+#endif
+
+/**
+ * @brief Bump allocator over a caller-provided or DMA-capable buffer.
+ *
+ * Slices are released all at once with hamming_arena_reset().
+ */
+typedef struct {
+    uint8_t *base; /**< First aligned byte of the buffer. */
+    size_t size;   /**< Usable bytes from base. */
+    size_t used;   /**< Bytes handed out so far. */
+    int owned;     /**< Non-zero if base was allocated by hamming_arena_create_dma(). */
+} hamming_arena_t;
+
+/**
+ * @brief Totals of the instrumented entry points, see hamming_counters_snapshot().
+ *
+ * Times are CPU cycles on ESP-IDF and nanoseconds elsewhere, they stay 0
+ * unless timing is enabled as well.
+ */
+typedef struct {
+    uint64_t encoded;        /**< Codewords produced by the encoders. */
+    uint64_t decoded;        /**< Codewords read by the decoders and correctors. */
+    uint64_t corrected;      /**< Single-bit errors corrected. */
+    uint64_t uncorrectable;  /**< Codewords with a detected double-bit error (SECDED). */
+    uint64_t encode_time;    /**< Time spent in the encoders. */
+    uint64_t decode_time;    /**< Time spent in the decoders and correctors. */
+} hamming_counters_t;
+
 /**
  * @brief Encode data using Hamming(7,4) error correction.
  *
@@ -29,18 +138,564 @@ extern "C" {
  *                     (including parity bits) will be stored.
  *
  * @note Ensure that the encoded_data array has been pre-allocated with
- * sufficient size to accommodate both the data and parity bits.
+ * sufficient size to accommodate both the data and parity bits, see
+ * hamming_encoded_bits_74().
  */
 void hamming_encode_74(const int *input_bits, int total_bits, int *out_bits);
 
+/**
+ * @brief The number of ints hamming_encode_74() writes for total_bits data bits.
+ *
+ * @return total_bits / 4 * 7
+ */
+int hamming_encoded_bits_74(int total_bits);
+
+/**
+ * @brief The number of codeword bytes for data_size bytes in the one-codeword-per-byte format.
+ *
+ * Applies to hamming74_encode_bytes(), hamming84_encode_bytes() and
+ * hamming_encode_generic().
+ *
+ * @return 2 * data_size
+ */
+size_t hamming74_encoded_size(size_t data_size);
+
 /**
  * @brief Decode Hamming(7,4) encoded data with error detection and correction.
  *
  * @param encoded_data Pointer to the array containing the encoded data bits (data and parity).
  * @param n The total number of bits in the encoded_data array.
  * @param decoded_data Pointer to the array where the original decoded data bits will be stored.
+ *                     The encoded data is only read, decoded_data may equal encoded_data.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+int hamming_decode_74(const int *in_bits, int total_bits, int *decoded_bits);
+
+/**
+ * @brief Decode Hamming(7,4) bits in place.
+ *
+ * The decoded bits overwrite the front of the buffer as codewords are
+ * consumed: bits [0, total_bits) hold the data afterwards, the rest of the
+ * buffer is left as is.
+ *
+ * @param bits Pointer to total_bits / 4 * 7 encoded bits.
+ * @param total_bits The number of data bits to decode.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+int hamming_decode_74_inplace(int *bits, int total_bits);
+
+/**
+ * @brief Soft-decision version of hamming_decode_74().
+ *
+ * Every codeword arrives as 7 log-likelihood ratios in the order of the
+ * encoded bits, positive values favour a 0 bit and the magnitude is the
+ * reliability. The decoder picks the most likely of the 16 codewords
+ * (maximum likelihood), which gains about 2 dB over slicing the LLRs and
+ * decoding the hard bits. Vectorized with SSE2 where available.
+ *
+ * @param llrs Pointer to total_bits / 4 * 7 LLRs.
+ * @param total_bits The number of data bits to decode.
+ * @param decoded_bits Output, total_bits bits.
+ * @return The number of codewords whose decision differs from the hard decision of their LLRs.
+ */
+int hamming_decode_74_soft(const int8_t *llrs, int total_bits, int *decoded_bits);
+
+/**
+ * @brief Encode packed bytes into Hamming(7,4) codewords, one codeword per byte.
+ *
+ * Every input byte yields two codewords, high nibble first. Each codeword
+ * occupies the low 7 bits of its byte with position 1 (P1) in bit 6 and
+ * position 7 (D4) in bit 0; bit 7 is always zero.
+ *
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param codewords Pointer to the output buffer, at least 2 * data_size bytes.
+ */
+void hamming74_encode_bytes(const uint8_t *data, size_t data_size, uint8_t *codewords);
+
+/**
+ * @brief Decode codewords produced by hamming74_encode_bytes(), correcting single-bit errors.
+ *
+ * @param codewords Pointer to 2 * data_size codeword bytes.
+ * @param data_size The number of bytes to decode.
+ * @param data Pointer to the output buffer, at least data_size bytes.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+size_t hamming74_decode_bytes(const uint8_t *codewords, size_t data_size, uint8_t *data);
+
+/**
+ * @brief Same as hamming74_decode_bytes(), additionally reporting the syndrome of every codeword.
+ *
+ * @param codewords Pointer to 2 * data_size codeword bytes.
+ * @param data_size The number of bytes to decode.
+ * @param data Pointer to the output buffer, at least data_size bytes.
+ * @param syndromes Optional (may be NULL) array of 2 * data_size entries, one per
+ *                  codeword: 0 for a clean codeword, otherwise the 1-based position
+ *                  of the bit that was corrected.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+size_t hamming74_decode_bytes_ex(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                 uint8_t *syndromes);
+
+/**
+ * @brief Decode one-per-byte codewords in place.
+ *
+ * Same as hamming74_decode_bytes() with data == codewords: the first
+ * data_size bytes of buf receive the data, so a receive buffer can be
+ * decoded without a second allocation.
+ *
+ * @param buf Pointer to 2 * data_size codeword bytes.
+ * @param data_size The number of bytes to decode.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+size_t hamming74_decode_bytes_inplace(uint8_t *buf, size_t data_size);
+
+/**
+ * @brief Soft-decision decoding into bytes, see hamming_decode_74_soft().
+ *
+ * @param llrs Pointer to 14 * data_size LLRs, the high nibble's codeword first.
+ * @param data_size The number of bytes to decode.
+ * @param data Output, data_size bytes.
+ * @return The number of codewords whose decision differs from the hard decision of their LLRs.
+ */
+size_t hamming74_decode_soft(const int8_t *llrs, size_t data_size, uint8_t *data);
+
+/**
+ * @brief Check one-per-byte Hamming(7,4) codewords for errors without decoding them.
+ *
+ * ORs the syndromes of the whole buffer with the fastest engine available,
+ * a clean buffer can then be decoded without correction. Bit 7 is ignored.
+ *
+ * @param codewords Pointer to the codewords.
+ * @param count The number of codewords (2 per data byte).
+ * @return 1 if every codeword is error-free, 0 otherwise.
+ */
+int hamming74_is_clean(const uint8_t *codewords, size_t count);
+
+/**
+ * @brief Repair one-per-byte Hamming(7,4) codewords in place.
+ *
+ * Codewords are checked 8 at a time with the syndromes only, and only the
+ * ones with an error are rewritten. Bit 7 is left as is.
+ *
+ * @param codewords Pointer to the codewords.
+ * @param count The number of codewords.
+ * @return The number of codewords that were corrected.
+ */
+size_t hamming74_correct_bytes(uint8_t *codewords, size_t count);
+
+/**
+ * @brief Encode an arbitrary object (struct, byte blob, ...) using Hamming(7,4).
+ *
+ * The object is treated as a stream of bytes and encoded exactly like
+ * hamming74_encode_bytes(): two codewords per byte, high nibble first.
+ *
+ * @param data Pointer to the object to be encoded.
+ * @param data_size The size of the object in bytes.
+ * @param codewords Pointer to the output buffer, at least 2 * data_size bytes.
+ */
+void hamming_encode_generic(const void *data, size_t data_size, uint8_t *codewords);
+
+/**
+ * @brief Decode an object encoded with hamming_encode_generic().
+ *
+ * @param codewords Pointer to 2 * data_size codeword bytes.
+ * @param data_size The size of the object in bytes.
+ * @param data Pointer to the object that receives the decoded bytes.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+size_t hamming_decode_generic(const uint8_t *codewords, size_t data_size, void *data);
+
+/**
+ * @brief Encode packed bytes into Hamming(8,4) SECDED codewords, one codeword per byte.
+ *
+ * Bits 0..6 of every codeword are the Hamming(7,4) codeword produced by
+ * hamming74_encode_bytes(), bit 7 is an extended parity bit over the other
+ * seven. Nibble order is the same: high nibble first.
+ *
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param codewords Pointer to the output buffer, at least 2 * data_size bytes.
+ */
+void hamming84_encode_bytes(const uint8_t *data, size_t data_size, uint8_t *codewords);
+
+/**
+ * @brief Decode Hamming(8,4) SECDED codewords, correcting single-bit and detecting double-bit errors.
+ *
+ * Codewords with a double-bit error are decoded without correction and
+ * counted as uncorrectable, the rest of the buffer is still decoded.
+ *
+ * @param codewords Pointer to 2 * data_size codeword bytes.
+ * @param data_size The number of bytes to decode.
+ * @param data Pointer to the output buffer, at least data_size bytes.
+ * @param stats Optional (may be NULL), the counts of this call are added to it.
+ * @return 0 if every codeword was decoded, -1 if at least one double-bit error was detected.
+ */
+int hamming84_decode_bytes(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                           hamming_stats_t *stats);
+
+/**
+ * @brief Decode Hamming(8,4) SECDED codewords in place, see hamming84_decode_bytes().
+ *
+ * @param buf Pointer to 2 * data_size codeword bytes, the first data_size receive the data.
+ * @param data_size The number of bytes to decode.
+ * @param stats Optional (may be NULL), the counts of this call are added to it.
+ * @return 0 if every codeword was decoded, -1 if at least one double-bit error was detected.
+ */
+int hamming84_decode_bytes_inplace(uint8_t *buf, size_t data_size, hamming_stats_t *stats);
+
+/**
+ * @brief Check Hamming(8,4) codewords for errors without decoding them.
+ *
+ * Computes only the syndromes and overall parity, 8 codewords per 64-bit word.
+ *
+ * @param codewords Pointer to the codewords.
+ * @param count The number of codewords (2 per data byte).
+ * @return 1 if every codeword is error-free, 0 otherwise.
+ */
+int hamming84_is_clean(const uint8_t *codewords, size_t count);
+
+/**
+ * @brief Repair Hamming(8,4) SECDED codewords in place, see hamming74_correct_bytes().
+ *
+ * Codewords with a double-bit error cannot be repaired and are left untouched.
+ *
+ * @param codewords Pointer to the codewords.
+ * @param count The number of codewords.
+ * @param stats Optional (may be NULL), the counts of this call are added to it.
+ * @return 0 if every codeword is now clean, -1 if a double-bit error was found.
+ */
+int hamming84_correct_bytes(uint8_t *codewords, size_t count, hamming_stats_t *stats);
+
+/**
+ * @brief Set up a generalized Hamming(n,k) codec.
+ *
+ * Any k from 1 to 64 is accepted, parity bits are added as needed: n = k + r
+ * gives a plain (possibly shortened) Hamming code, n = k + r + 1 adds an
+ * extended parity bit for SECDED. Typical choices are (7,4), (15,11),
+ * (31,26), (63,57) and the SECDED (8,4), (16,11), (32,26), (64,57), (72,64).
+ *
+ * @param codec The codec to initialize.
+ * @param n The codeword length in bits.
+ * @param k The number of data bits per codeword.
+ * @return 0 on success, -1 if (n,k) is not a valid Hamming or SECDED code.
+ */
+int hamming_codec_init(hamming_codec_t *codec, unsigned n, unsigned k);
+
+/**
+ * @brief The number of bytes hamming_codec_encode() writes for data_size bytes.
+ */
+size_t hamming_codec_encoded_size(const hamming_codec_t *codec, size_t data_size);
+
+/**
+ * @brief Encode a byte stream with a generalized Hamming code.
+ *
+ * Data is consumed k bits at a time, MSB first, the last codeword is zero
+ * padded. Codewords are written back to back as a dense MSB-first bit stream
+ * (extended parity bit first, then positions 1 to n), the last byte is zero
+ * padded.
+ *
+ * @param codec An initialized codec.
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param out Pointer to the output buffer, at least hamming_codec_encoded_size() bytes.
+ * @return The number of bytes written.
+ */
+size_t hamming_codec_encode(const hamming_codec_t *codec, const void *data, size_t data_size,
+                            uint8_t *out);
+
+/**
+ * @brief Decode a stream produced by hamming_codec_encode().
+ *
+ * @param codec The codec used for encoding.
+ * @param in Pointer to hamming_codec_encoded_size(codec, data_size) bytes.
+ * @param data_size The number of bytes to decode.
+ * @param data Pointer to the output buffer, at least data_size bytes.
+ * @param stats Optional (may be NULL), the counts of this call are added to it.
+ * @return 0 if every codeword was decoded, -1 if an uncorrectable error was detected.
+ */
+int hamming_codec_decode(const hamming_codec_t *codec, const uint8_t *in, size_t data_size,
+                         void *data, hamming_stats_t *stats);
+
+/**
+ * @brief The number of bytes hamming74_encode_packed() writes for data_size bytes.
+ *
+ * @return (data_size * 14 + 7) / 8
+ */
+size_t hamming74_packed_size(size_t data_size);
+
+/**
+ * @brief Pack one-per-byte codewords into consecutive 7-bit fields, MSB first.
+ *
+ * Every 8 codewords take exactly 7 bytes, the last byte is zero padded. Bit 7
+ * of the input codewords is ignored.
+ *
+ * @param codewords Pointer to count codewords, e.g. from hamming74_encode_bytes().
+ * @param count The number of codewords.
+ * @param packed Pointer to the output buffer, at least (count * 7 + 7) / 8 bytes.
+ * @return The number of bytes written to packed.
+ */
+size_t hamming74_pack(const uint8_t *codewords, size_t count, uint8_t *packed);
+
+/**
+ * @brief Unpack count 7-bit codewords written by hamming74_pack(), one codeword per byte.
+ *
+ * @param packed Pointer to at least (count * 7 + 7) / 8 bytes.
+ * @param count The number of codewords to unpack.
+ * @param codewords Pointer to the output buffer, at least count bytes.
+ */
+void hamming74_unpack(const uint8_t *packed, size_t count, uint8_t *codewords);
+
+/**
+ * @brief Encode bytes straight into the packed format.
+ *
+ * Same result as hamming74_encode_bytes() followed by hamming74_pack(), in
+ * one pass and without the intermediate buffer.
+ *
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param packed Pointer to the output buffer, at least hamming74_packed_size(data_size) bytes.
+ * @return The number of bytes written, hamming74_packed_size(data_size).
+ */
+size_t hamming74_encode_packed(const uint8_t *data, size_t data_size, uint8_t *packed);
+
+/**
+ * @brief Decode bytes from the packed format, correcting single-bit errors.
+ *
+ * @param packed Pointer to hamming74_packed_size(data_size) bytes.
+ * @param data_size The number of bytes to decode.
+ * @param data Pointer to the output buffer, at least data_size bytes.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+size_t hamming74_decode_packed(const uint8_t *packed, size_t data_size, uint8_t *data);
+
+/**
+ * @brief Decode the packed format in place, see hamming74_decode_packed().
+ *
+ * @param buf Pointer to hamming74_packed_size(data_size) bytes, the first data_size receive the data.
+ * @param data_size The number of bytes to decode.
+ * @return The number of codewords in which a single-bit error was corrected.
+ */
+size_t hamming74_decode_packed_inplace(uint8_t *buf, size_t data_size);
+
+/**
+ * @brief The number of bytes hamming74_encode_interleaved() writes.
+ *
+ * @param data_size The number of data bytes.
+ * @param depth The interleaver depth in codewords, a non-zero multiple of 8.
+ * @return 7 * depth / 8 bytes per started block of depth / 2 data bytes, 0 if depth is invalid.
+ */
+size_t hamming74_interleaved_size(size_t data_size, unsigned depth);
+
+/**
+ * @brief Encode bytes and interleave the codeword bits in blocks of depth codewords.
+ *
+ * Each block is a depth x 7 bit matrix of codewords that is written column
+ * by column (position 1 of every codeword first), so any burst of at most
+ * depth bit errors within a block is corrected. The last block is padded
+ * with zero data bytes.
+ *
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param depth The number of codewords per block, a non-zero multiple of 8.
+ * @param out Pointer to the output buffer, at least hamming74_interleaved_size(data_size, depth) bytes.
+ * @return 0 on success, -1 if depth is invalid.
+ */
+int hamming74_encode_interleaved(const uint8_t *data, size_t data_size, unsigned depth,
+                                 uint8_t *out);
+
+/**
+ * @brief De-interleave and decode a stream produced by hamming74_encode_interleaved().
+ *
+ * @param in Pointer to hamming74_interleaved_size(data_size, depth) bytes.
+ * @param data_size The number of bytes to decode.
+ * @param depth The depth used for encoding.
+ * @param data Pointer to the output buffer, at least data_size bytes.
+ * @param stats Optional (may be NULL), the number of corrected codewords is added to it.
+ * @return 0 on success, -1 if depth is invalid.
+ */
+int hamming74_decode_interleaved(const uint8_t *in, size_t data_size, unsigned depth,
+                                 uint8_t *data, hamming_stats_t *stats);
+
+/**
+ * @brief hamming74_encode_bytes() split across threads.
+ *
+ * The buffer is processed in cache-sized chunks claimed by worker threads
+ * started for this call, the caller is one of them. Uses pthreads on POSIX hosts and a
+ * task on the other core on ESP-IDF, elsewhere it runs on the caller only.
+ *
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param codewords Pointer to the output buffer, at least 2 * data_size bytes.
+ * @param threads The number of threads including the caller, 0 for one per core.
+ */
+void hamming74_encode_bytes_parallel(const uint8_t *data, size_t data_size, uint8_t *codewords,
+                                     unsigned threads);
+
+/**
+ * @brief hamming74_decode_bytes() split across threads, see hamming74_encode_bytes_parallel().
+ *
+ * @return The number of corrected codewords, summed over all threads.
+ */
+size_t hamming74_decode_bytes_parallel(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                       unsigned threads);
+
+/**
+ * @brief hamming84_encode_bytes() split across threads, see hamming74_encode_bytes_parallel().
+ */
+void hamming84_encode_bytes_parallel(const uint8_t *data, size_t data_size, uint8_t *codewords,
+                                     unsigned threads);
+
+/**
+ * @brief hamming84_decode_bytes() split across threads, see hamming74_encode_bytes_parallel().
+ *
+ * @param stats Optional (may be NULL), the counts of all threads are added to it.
+ * @return 0 if every codeword was decoded, -1 if at least one double-bit error was detected.
+ */
+int hamming84_decode_bytes_parallel(const uint8_t *codewords, size_t data_size, uint8_t *data,
+                                    unsigned threads, hamming_stats_t *stats);
+
+/**
+ * @brief Use a caller-provided buffer as an arena.
+ *
+ * @param arena The arena to initialize.
+ * @param buffer The backing memory, e.g. a static DMA-capable buffer. Its
+ *               unaligned head, if any, is skipped.
+ * @param size The size of buffer in bytes.
+ */
+void hamming_arena_init(hamming_arena_t *arena, void *buffer, size_t size);
+
+/**
+ * @brief Allocate an arena of size bytes in DMA-capable memory.
+ *
+ * Uses MALLOC_CAP_DMA on ESP-IDF and aligned_alloc() elsewhere. Release it
+ * with hamming_arena_destroy().
+ *
+ * @return 0 on success, -1 if the allocation failed.
+ */
+int hamming_arena_create_dma(hamming_arena_t *arena, size_t size);
+
+/**
+ * @brief Free the memory of an arena created by hamming_arena_create_dma().
+ *
+ * Arenas over caller-provided buffers are only cleared.
+ */
+void hamming_arena_destroy(hamming_arena_t *arena);
+
+/**
+ * @brief Take an aligned slice of size bytes from the arena.
+ *
+ * @return The slice, NULL if the arena does not have size bytes left.
+ */
+void *hamming_arena_alloc(hamming_arena_t *arena, size_t size);
+
+/**
+ * @brief Release every slice of the arena at once.
+ */
+void hamming_arena_reset(hamming_arena_t *arena);
+
+/**
+ * @brief Encode straight into a new arena slice.
+ *
+ * @param arena The arena the codewords are allocated from.
+ * @param format One codeword per byte or packed.
+ * @param data Pointer to the bytes to be encoded.
+ * @param data_size The number of bytes in data.
+ * @param encoded_size Optional (may be NULL), receives the number of bytes written.
+ * @return The codewords, NULL if the arena is too small.
+ */
+uint8_t *hamming74_encode_arena(hamming_arena_t *arena, hamming74_format_t format,
+                                const uint8_t *data, size_t data_size, size_t *encoded_size);
+
+/**
+ * @brief Start a new encode or decode stream.
+ *
+ * @param s The stream to initialize.
+ * @param mode Whether the stream encodes or decodes.
+ * @param format The codeword format on the encoded side.
+ */
+void hamming74_stream_init(hamming74_stream_t *s, hamming74_stream_mode_t mode,
+                           hamming74_format_t format);
+
+/**
+ * @brief The exact number of bytes hamming74_stream_update() will write for len input bytes.
+ *
+ * The bound is at most 2 * len when encoding and (len + 1) / 2 + 1 when decoding.
+ */
+size_t hamming74_stream_output_size(const hamming74_stream_t *s, size_t len);
+
+/**
+ * @brief Process a chunk of any size, carrying incomplete nibbles and codewords to the next call.
+ *
+ * @param s The stream.
+ * @param in Pointer to the input chunk.
+ * @param len The number of bytes in the chunk, may be 0.
+ * @param out Pointer to the output buffer, at least hamming74_stream_output_size(s, len) bytes.
+ * @return The number of bytes written to out.
+ */
+size_t hamming74_stream_update(hamming74_stream_t *s, const uint8_t *in, size_t len, uint8_t *out);
+
+/**
+ * @brief Finish a stream.
+ *
+ * A packed encoder writes its last partial byte, zero padded. A decoder
+ * drops trailing padding bits and writes nothing.
+ *
+ * @param s The stream, it must be initialized again before reuse.
+ * @param out Pointer to at least one byte of output.
+ * @return The number of bytes written to out (0 or 1).
+ */
+size_t hamming74_stream_final(hamming74_stream_t *s, uint8_t *out);
+
+/**
+ * @brief Check whether an engine is compiled in and supported by this CPU.
+ *
+ * @param engine The engine to query.
+ * @return 1 if the engine can be selected, 0 otherwise. AUTO is always available.
+ */
+int hamming74_engine_available(hamming74_engine_t engine);
+
+/**
+ * @brief Override the engine used by the byte API, mainly for testing and benchmarking.
+ *
+ * @param engine The engine to use, or HAMMING74_ENGINE_AUTO to pick the best one.
+ * @return 0 on success, -1 if the engine is not available (the current engine is kept).
+ */
+int hamming74_set_engine(hamming74_engine_t engine);
+
+/**
+ * @brief Get the engine currently used by the byte API.
+ *
+ * @return The resolved engine, never HAMMING74_ENGINE_AUTO.
+ */
+hamming74_engine_t hamming74_get_engine(void);
+
+/**
+ * @brief Get a short human-readable name for an engine, e.g. "avx2".
+ */
+const char *hamming74_engine_name(hamming74_engine_t engine);
+
+/**
+ * @brief Read the instrumentation counters summed over all cores.
+ *
+ * The encode and decode entry points of the bit and byte APIs count what
+ * they process when the library is built with CONFIG_HAMMING_COUNTERS
+ * (menuconfig or a compile definition), and time it with
+ * CONFIG_HAMMING_COUNTERS_TIMING. Without them the entry points carry no
+ * instrumentation at all.
+ *
+ * Every core (every thread on the host, up to 16) updates its own slot
+ * with relaxed atomics, so the totals may lag calls that are still running.
+ *
+ * @param out Receives the totals, zeroed if the counters are compiled out.
+ * @return 0 on success, -1 if the library was built without counters.
+ */
+int hamming_counters_snapshot(hamming_counters_t *out);
+
+/**
+ * @brief Reset all instrumentation counters to zero.
  */
-void hamming_decode_74(const int *in_bits, int total_bits, int *decoded_bits);
+void hamming_counters_reset(void);
 
 #ifdef __cplusplus
 }
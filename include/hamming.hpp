@@ -0,0 +1,371 @@
+/**
+ * @file hamming.hpp
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Header-only C++17 Hamming(N,K) codec with compile-time specialization.
+ *
+ * hamming::Codec<N, K> generates its parity masks and correction table as
+ * constexpr data for every (N, K), so the per-codeword work is a fixed
+ * sequence of masks, popcounts and shifts with no data-dependent branches.
+ * The wire format is identical to hamming_codec_t from hamming.h.
+ *
+ * @note
+ *  Supports codewords of up to 64 bits, use hamming_codec_t for (72,64).
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_HPP__
+#define __HAMMING_HPP__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+#include "hamming.h"
+
+namespace hamming {
+
+/*-----------------------------------------------------------*/
+/*   ------------------   Byte Spans   ------------------   */
+/*-----------------------------------------------------------*/
+
+#if defined(__cpp_lib_span)
+
+template <class T>
+using span = std::span<T>;
+
+#else
+
+/**
+ * @brief Minimal stand-in for std::span when building as C++17.
+ */
+template <class T>
+class span {
+public:
+    constexpr span() noexcept = default;
+    constexpr span(T *data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    template <std::size_t M>
+    constexpr span(T (&array)[M]) noexcept : data_(array), size_(M) {}
+
+    template <class Container, class = decltype(std::declval<Container &>().data())>
+    constexpr span(Container &c) noexcept : data_(c.data()), size_(c.size()) {}
+
+    template <class U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(const span<U> &other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    constexpr T *data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+
+private:
+    T *data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+#endif
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+namespace detail {
+
+/** Smallest r such that 2^r >= k + r + 1. */
+constexpr unsigned parity_bits(unsigned k)
+{
+    unsigned r = 2;
+    while ((1u << r) < k + r + 1) {
+        r++;
+    }
+    return r;
+}
+
+/** Parity (XOR of all bits) of a 64-bit word. */
+constexpr unsigned parity(std::uint64_t x)
+{
+    x ^= x >> 32;
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return static_cast<unsigned>(x & 1);
+}
+
+/** Mask with the low count bits set, count may be 64. */
+constexpr std::uint64_t low_mask(unsigned count)
+{
+    return count >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+}
+
+/**
+ * @brief MSB-first bit writer over a byte span, bytes past limit are dropped.
+ */
+class bit_writer {
+public:
+    explicit bit_writer(std::byte *out, std::size_t limit = SIZE_MAX) noexcept : out_(out), limit_(limit) {}
+
+    /** Append the low count bits (at most 64) of value. */
+    void put(std::uint64_t value, unsigned count) noexcept
+    {
+        if (count > 32) {
+            put32(value >> 32, count - 32);
+            count = 32;
+        }
+        put32(value, count);
+    }
+
+    /** Write out a partial last byte, zero padded. */
+    void flush() noexcept
+    {
+        if (bits_ != 0) {
+            put32(0, 8 - bits_);
+        }
+    }
+
+    std::size_t written() const noexcept { return pos_; }
+
+private:
+    void put32(std::uint64_t value, unsigned count) noexcept
+    {
+        acc_ = (acc_ << count) | (value & low_mask(count));
+        bits_ += count;
+        while (bits_ >= 8) {
+            bits_ -= 8;
+            if (pos_ < limit_) {
+                out_[pos_] = static_cast<std::byte>(acc_ >> bits_);
+            }
+            pos_++;
+        }
+    }
+
+    std::byte *out_;
+    std::size_t limit_;
+    std::size_t pos_ = 0;
+    std::uint64_t acc_ = 0;
+    unsigned bits_ = 0;
+};
+
+/**
+ * @brief MSB-first bit reader over a byte span, reads past the end return zero bits.
+ */
+class bit_reader {
+public:
+    bit_reader(const std::byte *in, std::size_t size) noexcept : in_(in), size_(size) {}
+
+    /** Read the next count bits (at most 64). */
+    std::uint64_t get(unsigned count) noexcept
+    {
+        if (count > 32) {
+            std::uint64_t hi = get32(count - 32);
+            return (hi << 32) | get32(32);
+        }
+        return get32(count);
+    }
+
+private:
+    std::uint64_t get32(unsigned count) noexcept
+    {
+        while (bits_ < count) {
+            acc_ = (acc_ << 8) | (pos_ < size_ ? std::to_integer<std::uint64_t>(in_[pos_]) : 0);
+            pos_++;
+            bits_ += 8;
+        }
+        bits_ -= count;
+        return (acc_ >> bits_) & low_mask(count);
+    }
+
+    const std::byte *in_;
+    std::size_t size_;
+    std::size_t pos_ = 0;
+    std::uint64_t acc_ = 0;
+    unsigned bits_ = 0;
+};
+
+}  // namespace detail
+
+/*-----------------------------------------------------------*/
+/*   ------------------   Codec<N,K>   ------------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Hamming(N,K) codec, N = K + r for a plain code or K + r + 1 for SECDED.
+ *
+ * A codeword is handled as an N-bit value in wire order: the extended parity
+ * bit (SECDED only) is the most significant bit, followed by positions 1 to
+ * K + r. Position p therefore lives in bit (K + r - p).
+ */
+template <unsigned N, unsigned K>
+class Codec {
+public:
+    static constexpr unsigned k = K;
+    static constexpr unsigned r = detail::parity_bits(K);
+    static constexpr unsigned n = N;
+    static constexpr bool secded = (N == K + r + 1);
+
+    static_assert(K >= 1 && K <= 64, "K must be between 1 and 64");
+    static_assert(N == K + r || secded, "N must be K + r (Hamming) or K + r + 1 (SECDED)");
+    static_assert(N <= 64, "codewords wider than 64 bits need hamming_codec_t");
+
+    /** Number of codewords needed for data_size bytes. */
+    static constexpr std::size_t codeword_count(std::size_t data_size) noexcept
+    {
+        return (data_size * 8 + K - 1) / K;
+    }
+
+    /** Number of bytes encode() writes for data_size bytes. */
+    static constexpr std::size_t encoded_size(std::size_t data_size) noexcept
+    {
+        return (codeword_count(data_size) * N + 7) / 8;
+    }
+
+    /** Encode K data bits (first bit in bit K-1) into an N-bit codeword. */
+    static constexpr std::uint64_t encode_word(std::uint64_t v) noexcept
+    {
+        std::uint64_t c = 0;
+        unsigned used = 0;
+        for (unsigned i = 1; i < r; i++) {
+            const unsigned len = run_length(i);
+            used += len;
+            c |= ((v >> (K - used)) & detail::low_mask(len)) << (last - run_end(i));
+        }
+        for (unsigned i = 0; i < r; i++) {
+            c |= std::uint64_t{detail::parity(c & layout.position_mask[i])} << (last - (1u << i));
+        }
+        if constexpr (secded) {
+            c |= std::uint64_t{detail::parity(c)} << last;
+        }
+        return c;
+    }
+
+    /**
+     * @brief Correct an N-bit codeword and return its K data bits.
+     *
+     * @param c The codeword.
+     * @param status Set to 0 (clean), 1 (corrected) or 2 (uncorrectable).
+     */
+    static constexpr std::uint64_t decode_word(std::uint64_t c, unsigned &status) noexcept
+    {
+        unsigned syndrome = 0;
+        for (unsigned i = 0; i < r; i++) {
+            syndrome |= detail::parity(c & layout.position_mask[i]) << i;
+        }
+
+        // SECDED: a single error flips the overall parity, a double error does not
+        const unsigned odd = secded ? detail::parity(c) : (syndrome != 0);
+        const unsigned bad = (syndrome > last) | (secded & (odd == 0) & (syndrome != 0));
+        c ^= layout.correction[syndrome] & (std::uint64_t{0} - std::uint64_t{bad == 0});
+        status = bad ? 2u : odd;
+
+        std::uint64_t v = 0;
+        for (unsigned i = 1; i < r; i++) {
+            const unsigned len = run_length(i);
+            v = (v << len) | ((c >> (last - run_end(i))) & detail::low_mask(len));
+        }
+        return v;
+    }
+
+    /**
+     * @brief Encode a byte stream, same format as hamming_codec_encode().
+     *
+     * @return The number of bytes written, 0 if out is smaller than encoded_size().
+     */
+    static std::size_t encode(span<const std::byte> in, span<std::byte> out) noexcept
+    {
+        if (out.size() < encoded_size(in.size())) {
+            return 0;
+        }
+        detail::bit_reader reader(in.data(), in.size());
+        detail::bit_writer writer(out.data());
+        const std::size_t count = codeword_count(in.size());
+        for (std::size_t i = 0; i < count; i++) {
+            writer.put(encode_word(reader.get(K)), N);
+        }
+        writer.flush();
+        return writer.written();
+    }
+
+    /**
+     * @brief Decode a stream produced by encode() into out.size() bytes.
+     *
+     * @param in At least encoded_size(out.size()) bytes of codewords.
+     * @param out Receives the decoded data, its size selects how much is decoded.
+     * @param stats Optional, the counts of this call are added to it.
+     * @return 0 if every codeword was decoded, -1 if an uncorrectable error was
+     *         detected or in is too short.
+     */
+    static int decode(span<const std::byte> in, span<std::byte> out, hamming_stats_t *stats = nullptr) noexcept
+    {
+        if (in.size() < encoded_size(out.size())) {
+            return -1;
+        }
+        detail::bit_reader reader(in.data(), in.size());
+        detail::bit_writer writer(out.data(), out.size());
+        hamming_stats_t local{0, 0};
+
+        const std::size_t count = codeword_count(out.size());
+        for (std::size_t i = 0; i < count; i++) {
+            unsigned status = 0;
+            writer.put(decode_word(reader.get(N), status), K);
+            local.corrected += (status == 1);
+            local.uncorrectable += (status == 2);
+        }
+
+        if (stats != nullptr) {
+            stats->corrected += local.corrected;
+            stats->uncorrectable += local.uncorrectable;
+        }
+        return local.uncorrectable != 0 ? -1 : 0;
+    }
+
+private:
+    /** Highest codeword position, also the bit index of the extended parity bit. */
+    static constexpr unsigned last = K + r;
+
+    /** Last data position before parity bit 2^(i+1). */
+    static constexpr unsigned run_end(unsigned i)
+    {
+        return (2u << i) - 1 < last ? (2u << i) - 1 : last;
+    }
+
+    /** Number of data positions between parity bits 2^i and 2^(i+1). */
+    static constexpr unsigned run_length(unsigned i)
+    {
+        return run_end(i) - (1u << i);
+    }
+
+    struct Layout {
+        std::array<std::uint64_t, r> position_mask{};       // Positions covered by parity bit 2^i
+        std::array<std::uint64_t, (1u << r)> correction{};  // Bit to flip for every syndrome
+    };
+
+    static constexpr Layout make_layout()
+    {
+        Layout l{};
+        for (unsigned p = 1; p <= last; p++) {
+            for (unsigned i = 0; i < r; i++) {
+                if (p & (1u << i)) {
+                    l.position_mask[i] |= std::uint64_t{1} << (last - p);
+                }
+            }
+            l.correction[p] = std::uint64_t{1} << (last - p);
+        }
+        return l;
+    }
+
+    static constexpr Layout layout = make_layout();
+};
+
+}  // namespace hamming
+
+#endif  // __HAMMING_HPP__
@@ -0,0 +1,64 @@
+/**
+ * @file hamming_batch.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Decoding many small frames in one call.
+ *
+ * Decoding a 40 byte frame on its own is mostly call overhead and the
+ * scalar tail after the last full vector. hamming_batch_decode() decodes the
+ * full vectors of every frame in place and the tails of many frames together
+ * in one staging buffer, then reports the outcome of every frame
+ * separately.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_BATCH_H__
+#define __HAMMING_BATCH_H__
+
+#include "hamming.h"
+#include "hamming_frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One frame of a batch.
+ *
+ * The caller fills in codewords, data and size. hamming_batch_decode() sets
+ * status and stats.
+ */
+typedef struct {
+    const uint8_t *codewords;       /**< 2 * size codeword bytes. */
+    uint8_t *data;                  /**< Output, size bytes, may be equal to codewords. */
+    size_t size;                    /**< Data bytes in the frame. */
+    hamming_frame_status_t status;  /**< CLEAN, CORRECTED or UNCORRECTABLE. */
+    hamming_stats_t stats;          /**< Errors found in this frame. */
+} hamming_batch_frame_t;
+
+/**
+ * @brief Decode a batch of frames.
+ *
+ * Frames are claimed in groups from a shared cursor by up to threads
+ * workers, the caller is one of them, see hamming74_encode_bytes_parallel().
+ * Small batches are decoded on the caller only.
+ *
+ * @param frames The frames, their status and stats are overwritten.
+ * @param count Number of frames.
+ * @param code HAMMING_FRAME_74 or HAMMING_FRAME_84, the same for all frames.
+ * @param threads The number of threads including the caller, 1 for none, 0 for one per core.
+ * @param stats Optional (may be NULL), the counts of all frames are added to it.
+ * @return 0 if every frame was decoded, -1 if at least one is HAMMING_FRAME_UNCORRECTABLE.
+ */
+int hamming_batch_decode(hamming_batch_frame_t *frames, size_t count, hamming_frame_code_t code,
+                         unsigned threads, hamming_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __HAMMING_BATCH_H__
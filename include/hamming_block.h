@@ -0,0 +1,108 @@
+/**
+ * @file hamming_block.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief ECC-protected page storage on flash or any other block device.
+ *
+ * Every page of data is stored as Hamming(8,4) SECDED codewords, two per
+ * data byte. Reads check the syndromes first and only run the correction
+ * path for pages that are not clean. Corrected and uncorrectable codewords
+ * are counted so that rewriting (scrubbing) can be scheduled.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_BLOCK_H__
+#define __HAMMING_BLOCK_H__
+
+#include "hamming.h"
+
+#if defined(ESP_PLATFORM)
+#include "esp_partition.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Storage backend, offsets and lengths are in device bytes.
+ *
+ * read, write and erase return 0 on success and -1 on failure. erase may be
+ * NULL for memory that needs no erase. map and unmap are optional, when
+ * present reads decode straight from the mapped memory.
+ */
+typedef struct {
+    void *ctx;          /**< Passed to every callback. */
+    size_t size;        /**< Device size in bytes. */
+    size_t erase_size;  /**< Erase granularity in bytes, 0 if erase is NULL. */
+    int (*read)(void *ctx, size_t offset, void *dst, size_t len);
+    int (*write)(void *ctx, size_t offset, const void *src, size_t len);
+    int (*erase)(void *ctx, size_t offset, size_t len);
+    const void *(*map)(void *ctx, size_t offset, size_t len, void **handle);
+    void (*unmap)(void *ctx, void *handle);
+} hamming_block_dev_t;
+
+/**
+ * @brief A page store on top of a device.
+ */
+typedef struct {
+    const hamming_block_dev_t *dev;
+    size_t page_size;       /**< Data bytes per page, the page takes 2 * page_size device bytes. */
+    size_t page_count;      /**< Pages that fit on the device. */
+    hamming_stats_t stats;  /**< Counts of all reads since hamming_block_init(). */
+} hamming_block_t;
+
+/**
+ * @brief Lay out pages of page_size data bytes on a device.
+ *
+ * @param block The page store to initialize.
+ * @param dev The device, it must outlive the store.
+ * @param page_size Data bytes per page. 2 * page_size must be a multiple of
+ *                  the erase size of the device.
+ * @return 0 on success, -1 if the page size does not fit the device.
+ */
+int hamming_block_init(hamming_block_t *block, const hamming_block_dev_t *dev, size_t page_size);
+
+/**
+ * @brief Erase (if needed), encode and write one page.
+ *
+ * @param block The page store.
+ * @param page The page index.
+ * @param data Pointer to page_size bytes.
+ * @return 0 on success, -1 on a bad page index or device error.
+ */
+int hamming_block_write(hamming_block_t *block, size_t page, const void *data);
+
+/**
+ * @brief Read and decode one page, correcting single-bit errors.
+ *
+ * @param block The page store, its stats are updated.
+ * @param page The page index.
+ * @param data Pointer to the output buffer, at least page_size bytes.
+ * @param stats Optional (may be NULL), the counts of this read are added to it.
+ * @return 0 if the page was decoded, -1 on a bad page index, a device error or
+ *         an uncorrectable (double-bit) error.
+ */
+int hamming_block_read(hamming_block_t *block, size_t page, void *data, hamming_stats_t *stats);
+
+#if defined(ESP_PLATFORM)
+
+/**
+ * @brief Device callbacks for a flash partition, reads use esp_partition_mmap().
+ *
+ * @param dev The device to fill in.
+ * @param partition The partition, e.g. from esp_partition_find_first().
+ */
+void hamming_block_dev_partition(hamming_block_dev_t *dev, const esp_partition_t *partition);
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __HAMMING_BLOCK_H__
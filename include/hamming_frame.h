@@ -0,0 +1,126 @@
+/**
+ * @file hamming_frame.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Frame codec: Hamming coding and a CRC in a single pass.
+ *
+ * A frame is the payload followed by its CRC, both encoded with Hamming(7,4)
+ * or Hamming(8,4) into one codeword per nibble. The CRC is computed chunk
+ * by chunk while the data is still in the cache of the encode or decode
+ * loop, saving the separate integrity pass over the frame. Decoding returns
+ * one status that tells clean, corrected, uncorrectable and CRC failures
+ * apart.
+ *
+ * CRC32 is the IEEE 802.3 / zlib CRC, stored little-endian. CRC16 is
+ * CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), stored big-endian. The ROM
+ * routines are used on ESP-IDF, the ARMv8 CRC32 instructions where available
+ * and slice-by-8 tables elsewhere.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_FRAME_H__
+#define __HAMMING_FRAME_H__
+
+#include "hamming.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initial value for hamming_crc16(). */
+#define HAMMING_CRC16_INIT 0xFFFFu
+
+/**
+ * @brief Codeword format of a frame.
+ */
+typedef enum {
+    HAMMING_FRAME_74 = 0,  /**< Hamming(7,4), as hamming74_encode_bytes(). */
+    HAMMING_FRAME_84,      /**< Hamming(8,4) SECDED, as hamming84_encode_bytes(). */
+} hamming_frame_code_t;
+
+/**
+ * @brief CRC appended to the payload.
+ */
+typedef enum {
+    HAMMING_CRC16 = 0,  /**< CRC-16/CCITT-FALSE, 2 bytes. */
+    HAMMING_CRC32,      /**< CRC-32 (IEEE), 4 bytes. */
+} hamming_crc_t;
+
+/**
+ * @brief Result of hamming_frame_decode(), from best to worst.
+ */
+typedef enum {
+    HAMMING_FRAME_CLEAN = 0,      /**< No bit errors, CRC matches. */
+    HAMMING_FRAME_CORRECTED,      /**< Single-bit errors were corrected, CRC matches. */
+    HAMMING_FRAME_UNCORRECTABLE,  /**< A SECDED codeword had a double-bit error. */
+    HAMMING_FRAME_CRC_FAIL,       /**< Decoded data does not match the CRC. */
+} hamming_frame_status_t;
+
+/**
+ * @brief Update a CRC-32 (IEEE) with more data.
+ *
+ * @param crc 0 for the first block, otherwise the previous result.
+ * @param data The data.
+ * @param size Number of bytes.
+ * @return The CRC of everything so far, e.g. 0xCBF43926 for "123456789".
+ */
+uint32_t hamming_crc32(uint32_t crc, const void *data, size_t size);
+
+/**
+ * @brief Update a CRC-16/CCITT-FALSE with more data.
+ *
+ * @param crc HAMMING_CRC16_INIT for the first block, otherwise the previous result.
+ * @param data The data.
+ * @param size Number of bytes.
+ * @return The CRC of everything so far, e.g. 0x29B1 for "123456789".
+ */
+uint16_t hamming_crc16(uint16_t crc, const void *data, size_t size);
+
+/**
+ * @brief Number of codeword bytes of a frame.
+ *
+ * @param payload_size Payload bytes.
+ * @param crc The CRC appended to the payload.
+ * @return 2 * (payload_size + CRC bytes), for both codes.
+ */
+size_t hamming_frame_encoded_size(size_t payload_size, hamming_crc_t crc);
+
+/**
+ * @brief Encode a payload and its CRC as one frame.
+ *
+ * @param payload The payload.
+ * @param payload_size Payload bytes.
+ * @param codewords Output, hamming_frame_encoded_size() bytes.
+ * @param code Codeword format.
+ * @param crc CRC to append.
+ * @return The number of codeword bytes written.
+ */
+size_t hamming_frame_encode(const uint8_t *payload, size_t payload_size, uint8_t *codewords,
+                            hamming_frame_code_t code, hamming_crc_t crc);
+
+/**
+ * @brief Decode a frame, correct single-bit errors and check its CRC.
+ *
+ * The payload is written even when the frame fails, so it can be inspected.
+ *
+ * @param codewords hamming_frame_encoded_size(payload_size, crc) bytes.
+ * @param payload_size Payload bytes.
+ * @param payload Output, payload_size bytes.
+ * @param code Codeword format the frame was encoded with.
+ * @param crc CRC the frame was encoded with.
+ * @param stats Optional, the counts of this frame are added to it.
+ * @return The frame status, uncorrectable takes precedence over a CRC failure.
+ */
+hamming_frame_status_t hamming_frame_decode(const uint8_t *codewords, size_t payload_size, uint8_t *payload,
+                                            hamming_frame_code_t code, hamming_crc_t crc,
+                                            hamming_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __HAMMING_FRAME_H__
@@ -0,0 +1,110 @@
+/**
+ * @file hamming_iov.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Scatter-gather Hamming(7,4) encoding and decoding.
+ *
+ * Input and output are arrays of segments, e.g. a header, a payload and a
+ * trailer in separate buffers, so frames never have to be assembled into
+ * one buffer first. Segments can have any length, including 0, and a
+ * codeword pair or packed codeword may be split over a segment boundary on
+ * either side.
+ *
+ * Include lwip/pbuf.h before this header to get hamming_iov_from_pbuf().
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_IOV_H__
+#define __HAMMING_IOV_H__
+
+#include "hamming.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief One segment of a scatter-gather list, laid out like struct iovec.
+ */
+typedef struct {
+    void *base; /**< First byte of the segment, only read for input lists. */
+    size_t len; /**< Length in bytes. */
+} hamming_iovec_t;
+
+/**
+ * @brief Total length of a scatter-gather list.
+ */
+size_t hamming_iov_size(const hamming_iovec_t *iov, size_t count);
+
+/**
+ * @brief Encode the concatenation of the input segments into the output segments.
+ *
+ * Produces exactly the bytes hamming74_encode_bytes() (HAMMING74_FORMAT_BYTES)
+ * or hamming74_encode_packed() (HAMMING74_FORMAT_PACKED) would write for the
+ * concatenated input, filling the output segments in order.
+ *
+ * @param in Input segments.
+ * @param in_count Number of input segments.
+ * @param out Output segments.
+ * @param out_count Number of output segments.
+ * @param format The codeword format.
+ * @return 0 on success, -1 if the output segments are too small (nothing is written).
+ */
+int hamming74_encode_iov(const hamming_iovec_t *in, size_t in_count, const hamming_iovec_t *out,
+                         size_t out_count, hamming74_format_t format);
+
+/**
+ * @brief Decode codewords from the input segments, filling every output segment.
+ *
+ * The total output length selects how many data bytes are decoded, trailing
+ * input beyond their codewords is ignored.
+ *
+ * @param in Input segments holding the codewords.
+ * @param in_count Number of input segments.
+ * @param out Output segments.
+ * @param out_count Number of output segments.
+ * @param format The codeword format.
+ * @param stats Optional, corrected codewords are added to it.
+ * @return 0 on success, -1 if the input holds too few codewords (nothing is written).
+ */
+int hamming74_decode_iov(const hamming_iovec_t *in, size_t in_count, const hamming_iovec_t *out,
+                         size_t out_count, hamming74_format_t format, hamming_stats_t *stats);
+
+#if defined(LWIP_HDR_PBUF_H)
+/**
+ * @brief Describe a pbuf chain as a scatter-gather list.
+ *
+ * @param p First pbuf of the chain.
+ * @param iov Receives one segment per pbuf.
+ * @param max Capacity of iov.
+ * @return The number of segments, or 0 if the chain has more than max pbufs.
+ */
+static inline size_t hamming_iov_from_pbuf(const struct pbuf *p, hamming_iovec_t *iov, size_t max)
+{
+    size_t count = 0;
+    for (; p != NULL; p = p->next) {
+        if (count == max) {
+            return 0;
+        }
+        iov[count].base = p->payload;
+        iov[count].len = p->len;
+        count++;
+
+        // The last pbuf of a packet, next may already be the following packet
+        if (p->tot_len == p->len) {
+            break;
+        }
+    }
+    return count;
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __HAMMING_IOV_H__
@@ -0,0 +1,116 @@
+/**
+ * @file hamming_pipeline.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Hamming(7,4) encode/decode on a dedicated FreeRTOS task.
+ *
+ * A pipeline owns a worker task, normally pinned to the core that does not
+ * run the radio stack, and two lock-free single-producer single-consumer
+ * ring buffers. The application writes raw bytes into the input ring and
+ * reads results from the output ring, neither call ever blocks.
+ *
+ * @note
+ *  Only available on ESP-IDF with CONFIG_HAMMING_PIPELINE enabled
+ *  (menuconfig: Component config -> Hamming codec).
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_PIPELINE_H__
+#define __HAMMING_PIPELINE_H__
+
+#include "hamming.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Flushes that may be pending at a time, see hamming_pipeline_flush(). */
+#define HAMMING_PIPELINE_MAX_FLUSHES 8
+
+/**
+ * @brief A running pipeline, see hamming_pipeline_create().
+ */
+typedef struct hamming_pipeline hamming_pipeline_t;
+
+/**
+ * @brief Pipeline settings.
+ */
+typedef struct {
+    hamming74_stream_mode_t mode; /**< Encode or decode. */
+    hamming74_format_t format;    /**< Codeword format on the encoded side. */
+    size_t in_capacity;           /**< Input ring size in bytes, a power of two. */
+    size_t out_capacity;          /**< Output ring size in bytes, a power of two. */
+    int core;                     /**< Core the worker task is pinned to. */
+    unsigned priority;            /**< FreeRTOS priority of the worker task. */
+    void (*on_output)(void *ctx); /**< Optional, called on the worker task after output was added. */
+    void *ctx;                    /**< Passed to on_output. */
+} hamming_pipeline_config_t;
+
+/**
+ * @brief Default settings: 4 KiB input and 8 KiB output rings on CONFIG_HAMMING_PIPELINE_CORE.
+ */
+#define HAMMING_PIPELINE_CONFIG_DEFAULT(MODE, FORMAT)                                       \
+    {                                                                                       \
+        (MODE), (FORMAT), 4096, 8192, CONFIG_HAMMING_PIPELINE_CORE,                         \
+            CONFIG_HAMMING_PIPELINE_PRIORITY, NULL, NULL                                    \
+    }
+
+/**
+ * @brief Allocate the rings and start the worker task.
+ *
+ * @param config The pipeline settings.
+ * @return The pipeline, NULL if a ring size is not a power of two or allocation failed.
+ */
+hamming_pipeline_t *hamming_pipeline_create(const hamming_pipeline_config_t *config);
+
+/**
+ * @brief Stop the worker task and free the pipeline, data still in the rings is dropped.
+ */
+void hamming_pipeline_destroy(hamming_pipeline_t *pipeline);
+
+/**
+ * @brief Queue bytes for the worker, never blocks.
+ *
+ * Must always be called from the same task.
+ *
+ * @return The number of bytes accepted, less than len if the input ring is full.
+ */
+size_t hamming_pipeline_write(hamming_pipeline_t *pipeline, const uint8_t *data, size_t len);
+
+/**
+ * @brief Take processed bytes from the output ring, never blocks.
+ *
+ * Must always be called from the same task.
+ *
+ * @return The number of bytes copied to out, 0 if nothing is ready.
+ */
+size_t hamming_pipeline_read(hamming_pipeline_t *pipeline, uint8_t *out, size_t len);
+
+/**
+ * @brief End the current frame after the bytes written so far.
+ *
+ * A packed encoder emits its zero-padded last byte, a decoder drops the
+ * padding bits. The next write starts a new frame, even if the worker has
+ * not caught up with the previous one yet.
+ *
+ * Must be called from the task that calls hamming_pipeline_write().
+ *
+ * @return 0 on success, -1 if HAMMING_PIPELINE_MAX_FLUSHES flushes are already
+ *         pending, call again after the worker has caught up.
+ */
+int hamming_pipeline_flush(hamming_pipeline_t *pipeline);
+
+/**
+ * @brief Codewords corrected by a decoding pipeline since it was created.
+ */
+size_t hamming_pipeline_corrected(const hamming_pipeline_t *pipeline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __HAMMING_PIPELINE_H__
@@ -0,0 +1,100 @@
+/**
+ * @file hamming_scrub.h
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Incremental background scrubbing of ECC-protected memory.
+ *
+ * Regions of codewords kept in RAM or PSRAM are registered with a scrubber,
+ * and every hamming_scrub_tick() checks a fixed number of codewords,
+ * continuing where the last tick stopped. Single-bit upsets are repaired
+ * before a second upset in the same codeword makes it uncorrectable, with
+ * a bounded amount of work per tick.
+ *
+ * @note
+ *  The scrubber writes corrected codewords back one byte at a time. The
+ *  application must not rewrite a region while it is being scrubbed.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#ifndef __HAMMING_SCRUB_H__
+#define __HAMMING_SCRUB_H__
+
+#include "hamming.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Codeword format of a scrubbed region.
+ */
+typedef enum {
+    HAMMING_SCRUB_74 = 0,  /**< One Hamming(7,4) codeword per byte. */
+    HAMMING_SCRUB_84,      /**< One Hamming(8,4) SECDED codeword per byte. */
+} hamming_scrub_code_t;
+
+/**
+ * @brief A region of codewords, linked into a scrubber and owned by the caller.
+ */
+typedef struct hamming_scrub_region {
+    struct hamming_scrub_region *next; /**< Next region of the scrubber. */
+    uint8_t *codewords;                /**< The protected codewords. */
+    size_t count;                      /**< Number of codewords. */
+    size_t cursor;                     /**< Next codeword to check. */
+    hamming_scrub_code_t code;         /**< Codeword format. */
+    hamming_stats_t stats;             /**< Repairs in this region. */
+} hamming_scrub_region_t;
+
+/**
+ * @brief Round-robin scrubber over a list of regions.
+ */
+typedef struct {
+    hamming_scrub_region_t *head;    /**< First registered region. */
+    hamming_scrub_region_t *current; /**< Region the next tick starts in. */
+    size_t budget;                   /**< Codewords checked per tick. */
+    size_t passes;                   /**< Completed passes over all regions. */
+    hamming_stats_t stats;           /**< Repairs in all regions. */
+} hamming_scrubber_t;
+
+/**
+ * @brief Initialize a scrubber without regions.
+ *
+ * @param scrubber The scrubber.
+ * @param codewords_per_tick The number of codewords every tick checks.
+ */
+void hamming_scrub_init(hamming_scrubber_t *scrubber, size_t codewords_per_tick);
+
+/**
+ * @brief Describe a region of codewords.
+ */
+void hamming_scrub_region_init(hamming_scrub_region_t *region, hamming_scrub_code_t code,
+                               uint8_t *codewords, size_t count);
+
+/**
+ * @brief Register a region, it must stay valid until removed.
+ */
+void hamming_scrub_add(hamming_scrubber_t *scrubber, hamming_scrub_region_t *region);
+
+/**
+ * @brief Unregister a region.
+ */
+void hamming_scrub_remove(hamming_scrubber_t *scrubber, hamming_scrub_region_t *region);
+
+/**
+ * @brief Check and repair the next codewords_per_tick codewords.
+ *
+ * Call it from a timer task or the idle hook.
+ *
+ * @return The number of codewords repaired in this tick.
+ */
+size_t hamming_scrub_tick(hamming_scrubber_t *scrubber);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // __HAMMING_SCRUB_H__
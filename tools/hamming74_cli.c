@@ -0,0 +1,436 @@
+/**
+ * @file hamming74_cli.c
+ * @author Hossein Molavi (hmolavi@uwaterloo.ca)
+ *
+ * @brief Command line tool protecting whole files with Hamming codes.
+ *
+ * encode writes a 16-byte header followed by the codewords of the input
+ * file, decode restores the original file and verify only decodes and
+ * reports the errors found. The input is memory-mapped and read
+ * sequentially. It is cut into chunks of CLI_CHUNK data bytes that worker
+ * threads claim from a shared counter, encode or decode into their own
+ * buffer and write to their final offset with one pwrite() each, so the
+ * output never needs to be reordered.
+ *
+ * Header, all integers little-endian:
+ *   0  "HM74"
+ *   4  format version, 1
+ *   5  code, cli_code_t
+ *   6  reserved, 0
+ *   8  data bytes (uint64)
+ *
+ * Usage: hamming74-cli encode|decode|verify [--code 74|74-packed|84] [--threads N] IN [OUT]
+ *
+ * Exits with 0 on success, 1 on bad usage or an I/O error and 2 if a
+ * double-bit error was detected in a SECDED file.
+ *
+ * @version 1.0
+ * @date 2025-04-13
+ *
+ * @copyright Copyright (c) 2025
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "hamming.h"
+
+#define CLI_MAGIC "HM74"
+#define CLI_VERSION 1
+#define CLI_HEADER_SIZE 16
+
+/** Data bytes per chunk, a multiple of 4 so packed chunks end on a byte boundary. */
+#define CLI_CHUNK ((size_t)4 * 1024 * 1024)
+
+/** Upper bound on worker threads, including the main thread. */
+#define CLI_MAX_THREADS 64
+
+/*-----------------------------------------------------------*/
+/*   ---------------   Job Description   ------------------   */
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Codeword format of a file, stored in the header.
+ */
+typedef enum {
+    CODE_74 = 0,     /**< Hamming(7,4), one codeword per byte. */
+    CODE_74_PACKED,  /**< Hamming(7,4), dense 7-bit codewords. */
+    CODE_84,         /**< Hamming(8,4) SECDED, one codeword per byte. */
+    CODE_COUNT
+} cli_code_t;
+
+static const char *const code_names[CODE_COUNT] = {"74", "74-packed", "84"};
+
+/**
+ * @brief One encode, decode or verify run, shared by all workers.
+ */
+typedef struct {
+    int decode;
+    cli_code_t code;
+    const uint8_t *in;  // Data for encode, codewords after the header for decode
+    size_t data_size;
+    int out_fd;         // -1 to discard the output (verify)
+    _Atomic size_t next;  // Next unclaimed chunk
+    _Atomic int failed;
+    _Atomic size_t corrected;
+    _Atomic size_t uncorrectable;
+} job_t;
+
+/*-----------------------------------------------------------*/
+/*   --------------   Helper Functions   -----------------   */
+/*-----------------------------------------------------------*/
+
+static size_t encoded_size(cli_code_t code, size_t data_size)
+{
+    return (code == CODE_74_PACKED) ? hamming74_packed_size(data_size) : 2 * data_size;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t encode_chunk(cli_code_t code, const uint8_t *data, size_t len, uint8_t *out)
+{
+    switch (code) {
+    case CODE_74:
+        hamming74_encode_bytes(data, len, out);
+        break;
+    case CODE_74_PACKED:
+        return hamming74_encode_packed(data, len, out);
+    default:
+        hamming84_encode_bytes(data, len, out);
+        break;
+    }
+    return 2 * len;
+}
+
+/*-----------------------------------------------------------*/
+
+static void decode_chunk(cli_code_t code, const uint8_t *in, size_t len, uint8_t *data, hamming_stats_t *stats)
+{
+    switch (code) {
+    case CODE_74:
+        stats->corrected += hamming74_decode_bytes(in, len, data);
+        break;
+    case CODE_74_PACKED:
+        stats->corrected += hamming74_decode_packed(in, len, data);
+        break;
+    default:
+        (void)hamming84_decode_bytes(in, len, data, stats);
+        break;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief pwrite() all of buf, retrying short writes.
+ */
+static int write_all(int fd, const uint8_t *buf, size_t len, off_t offset)
+{
+    while (len > 0) {
+        ssize_t n = pwrite(fd, buf, len, offset);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        buf += n;
+        len -= (size_t)n;
+        offset += n;
+    }
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Claim and process chunks until the job is done or has failed.
+ */
+static void *work(void *arg)
+{
+    job_t *job = (job_t *)arg;
+    hamming_stats_t stats = {0, 0};
+
+    uint8_t *buf = malloc(2 * CLI_CHUNK);
+    if (buf == NULL) {
+        atomic_store(&job->failed, 1);
+        return NULL;
+    }
+
+    while (!atomic_load_explicit(&job->failed, memory_order_relaxed)) {
+        size_t begin = atomic_fetch_add_explicit(&job->next, 1, memory_order_relaxed) * CLI_CHUNK;
+        if (begin >= job->data_size) {
+            break;
+        }
+        size_t len = (job->data_size - begin < CLI_CHUNK) ? job->data_size - begin : CLI_CHUNK;
+
+        size_t out_len;
+        off_t out_offset;
+        if (job->decode) {
+            decode_chunk(job->code, job->in + encoded_size(job->code, begin), len, buf, &stats);
+            out_len = len;
+            out_offset = (off_t)begin;
+        } else {
+            out_len = encode_chunk(job->code, job->in + begin, len, buf);
+            out_offset = (off_t)(CLI_HEADER_SIZE + encoded_size(job->code, begin));
+        }
+
+        if (job->out_fd >= 0 && write_all(job->out_fd, buf, out_len, out_offset) != 0) {
+            perror("write");
+            atomic_store(&job->failed, 1);
+        }
+    }
+
+    atomic_fetch_add(&job->corrected, stats.corrected);
+    atomic_fetch_add(&job->uncorrectable, stats.uncorrectable);
+    free(buf);
+    return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Run a job on up to threads threads, the main thread included.
+ */
+static void run_job(job_t *job, unsigned threads)
+{
+    size_t chunks = (job->data_size + CLI_CHUNK - 1) / CLI_CHUNK;
+    if (threads > CLI_MAX_THREADS) {
+        threads = CLI_MAX_THREADS;
+    }
+    if (threads > chunks) {
+        threads = (chunks > 0) ? (unsigned)chunks : 1;
+    }
+
+    pthread_t handles[CLI_MAX_THREADS];
+    unsigned started = 0;
+    while (started + 1 < threads && pthread_create(&handles[started], NULL, work, job) == 0) {
+        started++;
+    }
+
+    work(job);
+    for (unsigned t = 0; t < started; t++) {
+        pthread_join(handles[t], NULL);
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Map a whole file read-only for sequential access.
+ *
+ * @return The mapping, NULL for an empty file, MAP_FAILED on error.
+ */
+static const uint8_t *map_input(const char *path, size_t *size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return MAP_FAILED;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (uintmax_t)st.st_size > SIZE_MAX) {
+        fprintf(stderr, "%s: cannot map file\n", path);
+        close(fd);
+        return MAP_FAILED;
+    }
+    *size = (size_t)st.st_size;
+    if (*size == 0) {
+        close(fd);
+        return NULL;
+    }
+
+    void *map = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return MAP_FAILED;
+    }
+    posix_madvise(map, *size, POSIX_MADV_SEQUENTIAL);
+    return (const uint8_t *)map;
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Create the output file at its final size.
+ */
+static int open_output(const char *path, off_t size)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+    if (ftruncate(fd, size) != 0) {
+        perror(path);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/*-----------------------------------------------------------*/
+
+static void store_header(uint8_t header[CLI_HEADER_SIZE], cli_code_t code, uint64_t data_size)
+{
+    memset(header, 0, CLI_HEADER_SIZE);
+    memcpy(header, CLI_MAGIC, 4);
+    header[4] = CLI_VERSION;
+    header[5] = (uint8_t)code;
+    for (int i = 0; i < 8; i++) {
+        header[8 + i] = (uint8_t)(data_size >> (8 * i));
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Check the header against the size of the file.
+ *
+ * @return 0 on success, -1 if the file is not a complete encoded file.
+ */
+static int parse_header(const uint8_t *file, size_t file_size, cli_code_t *code, size_t *data_size)
+{
+    if (file_size < CLI_HEADER_SIZE || memcmp(file, CLI_MAGIC, 4) != 0) {
+        fprintf(stderr, "not an encoded file\n");
+        return -1;
+    }
+    if (file[4] != CLI_VERSION || file[5] >= CODE_COUNT) {
+        fprintf(stderr, "unsupported format version %u, code %u\n", file[4], file[5]);
+        return -1;
+    }
+
+    uint64_t size = 0;
+    for (int i = 0; i < 8; i++) {
+        size |= (uint64_t)file[8 + i] << (8 * i);
+    }
+    *code = (cli_code_t)file[5];
+    // Every code takes more than a byte per data byte, which keeps encoded_size() from overflowing
+    if (size > file_size - CLI_HEADER_SIZE || encoded_size(*code, (size_t)size) != file_size - CLI_HEADER_SIZE) {
+        fprintf(stderr, "truncated or corrupt file, header says %llu data bytes\n", (unsigned long long)size);
+        return -1;
+    }
+    *data_size = (size_t)size;
+    return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr,
+            "usage: %s encode [--code 74|74-packed|84] [--threads N] IN OUT\n"
+            "       %s decode [--threads N] IN OUT\n"
+            "       %s verify [--threads N] IN\n",
+            argv0, argv0, argv0);
+    exit(1);
+}
+
+/*-----------------------------------------------------------*/
+/*  -----------------       Main         -----------------   */
+/*-----------------------------------------------------------*/
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        usage(argv[0]);
+    }
+    const char *cmd = argv[1];
+    int encode = strcmp(cmd, "encode") == 0;
+    int verify = strcmp(cmd, "verify") == 0;
+    if (!encode && !verify && strcmp(cmd, "decode") != 0) {
+        usage(argv[0]);
+    }
+
+    cli_code_t code = CODE_74_PACKED;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned threads = (online > 0) ? (unsigned)online : 1;
+    const char *paths[2] = {NULL, NULL};
+    int npaths = 0;
+
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--code") == 0 && i + 1 < argc && encode) {
+            const char *name = argv[++i];
+            for (code = 0; code < CODE_COUNT && strcmp(name, code_names[code]) != 0; code++) {
+            }
+            if (code == CODE_COUNT) {
+                usage(argv[0]);
+            }
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = (unsigned)strtoul(argv[++i], NULL, 0);
+            if (threads == 0) {
+                threads = 1;
+            }
+        } else if (argv[i][0] != '-' && npaths < 2) {
+            paths[npaths++] = argv[i];
+        } else {
+            usage(argv[0]);
+        }
+    }
+    if (npaths != (verify ? 1 : 2)) {
+        usage(argv[0]);
+    }
+
+    size_t file_size = 0;
+    const uint8_t *file = map_input(paths[0], &file_size);
+    if (file == MAP_FAILED) {
+        return 1;
+    }
+
+    job_t job = {.decode = !encode, .code = code, .out_fd = -1};
+
+    if (encode) {
+        job.in = file;
+        job.data_size = file_size;
+        off_t size = (off_t)(CLI_HEADER_SIZE + encoded_size(code, file_size));
+        uint8_t header[CLI_HEADER_SIZE];
+        store_header(header, code, file_size);
+        job.out_fd = open_output(paths[1], size);
+        if (job.out_fd < 0 || write_all(job.out_fd, header, CLI_HEADER_SIZE, 0) != 0) {
+            return 1;
+        }
+    } else {
+        if (parse_header(file, file_size, &job.code, &job.data_size) != 0) {
+            return 1;
+        }
+        job.in = file + CLI_HEADER_SIZE;
+        if (!verify) {
+            job.out_fd = open_output(paths[1], (off_t)job.data_size);
+            if (job.out_fd < 0) {
+                return 1;
+            }
+        }
+    }
+
+    run_job(&job, threads);
+
+    if (job.out_fd >= 0 && close(job.out_fd) != 0) {
+        perror(paths[1]);
+        return 1;
+    }
+    if (file != NULL) {
+        munmap((void *)file, file_size);
+    }
+    if (atomic_load(&job.failed)) {
+        return 1;
+    }
+
+    if (!encode) {
+        fprintf(stderr, "%s: %zu bytes, code %s, %zu corrected, %zu uncorrectable\n", paths[0], job.data_size,
+                code_names[job.code], atomic_load(&job.corrected), atomic_load(&job.uncorrectable));
+    }
+    return (atomic_load(&job.uncorrectable) != 0) ? 2 : 0;
+}